@@ -0,0 +1,1614 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <forward_list>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "BenchmarksSingleLinkedList.h"
+#include "ConstexprSingleLinkedList.h"
+#include "CowSingleLinkedList.h"
+#include "HashIndexedSingleLinkedList.h"
+#include "LinkedHashMap.h"
+#include "LruCache.h"
+#include "MappedSingleLinkedList.h"
+#include "ParallelSingleLinkedList.h"
+#include "PersistentSingleLinkedList.h"
+#include "PerfCounters.h"
+#include "PrefetchSingleLinkedList.h"
+#include "SortedSingleLinkedList.h"
+#include "StaticSingleLinkedList.h"
+#include "StreamingSingleLinkedList.h"
+
+// Списки int64 в группе hashing хранят кэш хэша, uint64 - нет
+template <>
+struct EnableListHashCache<std::int64_t> : std::true_type {};
+
+// Списки long long в группе positional хранят индекс позиций, uint64 - нет
+template <>
+struct EnableListPositionIndex<long long> : std::true_type {};
+
+// Группа inline: 64-битное слово, первые четыре узла списков которого встроены в сам список
+struct InlineWord {
+    InlineWord() = default;
+    InlineWord(std::uint64_t v) noexcept : value(v) {}
+    operator std::uint64_t() const noexcept {return value;}
+
+    std::uint64_t value = 0;
+};
+
+template <>
+struct ListInlineNodes<InlineWord> : std::integral_constant<size_t, 4> {};
+
+// Группа trivial: одинаковые POD-структуры, у второй побайтовый путь списка выключен
+struct TrivialPoint {
+    TrivialPoint() = default;
+    explicit TrivialPoint(size_t i) noexcept : x(static_cast<double>(i)), y(-x) {}
+
+    double x;
+    double y;
+};
+
+struct GenericPoint {
+    GenericPoint() = default;
+    explicit GenericPoint(size_t i) noexcept : x(static_cast<double>(i)), y(-x) {}
+
+    double x;
+    double y;
+};
+
+template <>
+struct ListTrivialValues<GenericPoint> : std::false_type {};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Результат одного замера
+struct BenchmarkRecord {
+    std::string group;              // Группа бенчмарков
+    std::string container;          // Контейнер или вариант алгоритма
+    std::string operation;          // Измеряемая операция
+    std::string type;               // Тип элементов
+    size_t size = 0;                // Количество элементов в контейнере
+    double total_ms = 0.0;          // Время на один контейнер
+    double ns_per_element = 0.0;    // Время в пересчёте на элемент
+    std::vector<std::pair<std::string, double>> params;  // Дополнительные параметры замера
+    PerfCounters::Values counters;  // Аппаратные счётчики в пересчёте на элемент
+};
+
+// Время и значения аппаратных счётчиков за один запуск
+struct Measurement {
+    double ms = 0.0;
+    PerfCounters::Values counters;
+};
+
+// Счётчики в пересчёте на один элемент
+PerfCounters::Values PerElement(PerfCounters::Values counters, size_t elements) {
+    for (auto& [name, value] : counters) {
+        value /= static_cast<double>(std::max<size_t>(elements, 1));
+    }
+    return counters;
+}
+
+// Собирает результаты замеров, печатает их по мере поступления и сохраняет в JSON
+class BenchmarkReport {
+public:
+    explicit BenchmarkReport(bool use_perf_counters);
+
+    void Add(BenchmarkRecord record);
+    void WriteJson(std::ostream& out) const;
+
+    // Выполняет f repeats раз и возвращает лучшее время вместе со счётчиками этого запуска
+    template <typename F>
+    Measurement Measure(F&& f, int repeats = 3);
+
+    // Запуск и остановка счётчиков вокруг произвольного участка кода
+    void StartCounters() noexcept;
+    [[nodiscard]] PerfCounters::Values StopCounters() noexcept;
+
+private:
+    std::vector<BenchmarkRecord> records_;
+    std::unique_ptr<PerfCounters> perf_;
+};
+
+BenchmarkReport::BenchmarkReport(bool use_perf_counters) {
+    if (!use_perf_counters) {
+        return;
+    }
+    perf_ = std::make_unique<PerfCounters>();
+    if (!perf_->GetDiagnostics().empty()) {
+        std::cout << "Hardware counters: " << perf_->GetDiagnostics() << std::endl;
+    }
+    if (!perf_->IsAvailable()) {
+        std::cout << "Hardware counters are unavailable, reporting wall-clock time only" << std::endl;
+        perf_.reset();
+    }
+}
+
+template <typename F>
+Measurement BenchmarkReport::Measure(F&& f, int repeats) {
+    Measurement best;
+    for (int i = 0; i < repeats; ++i) {
+        StartCounters();
+        const auto start = Clock::now();
+        f();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        auto counters = StopCounters();
+        if (i == 0 || elapsed.count() < best.ms) {
+            best.ms = elapsed.count();
+            best.counters = std::move(counters);
+        }
+    }
+    return best;
+}
+
+void BenchmarkReport::StartCounters() noexcept {
+    if (perf_) {
+        perf_->Start();
+    }
+}
+
+[[nodiscard]] PerfCounters::Values BenchmarkReport::StopCounters() noexcept {
+    return perf_ ? perf_->Stop() : PerfCounters::Values{};
+}
+
+void BenchmarkReport::Add(BenchmarkRecord record) {
+    std::cout << "  " << std::left << std::setw(28) << record.container
+              << std::setw(14) << record.operation
+              << std::setw(10) << record.type
+              << std::right << std::setw(11) << record.size
+              << std::fixed << std::setprecision(3)
+              << std::setw(14) << record.ns_per_element << " ns/elem"
+              << std::setw(12) << record.total_ms << " ms";
+    for (const auto& [name, value] : record.params) {
+        std::cout << "  " << name << '=' << value;
+    }
+    for (const auto& [name, value] : record.counters) {
+        std::cout << "  " << name << '=' << value;
+    }
+    std::cout << std::endl;
+    records_.push_back(std::move(record));
+}
+
+// Строка в кавычках с экранированием спецсимволов JSON.
+// Управляющие символы (меньше 0x20) без короткой формы записываются как \u00XX
+std::string JsonString(const std::string& value) {
+    std::ostringstream out;
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u00" << std::hex << std::setw(2) << std::setfill('0')
+                    << static_cast<int>(static_cast<unsigned char>(c));
+            } else {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+// Число JSON: бесконечность и NaN в JSON не представимы и записываются как null
+void WriteJsonNumber(std::ostream& out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+void BenchmarkReport::WriteJson(std::ostream& out) const {
+    out << "{\n  \"benchmarks\": [";
+    bool first = true;
+    for (const BenchmarkRecord& record : records_) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    {\"group\": " << JsonString(record.group)
+            << ", \"container\": " << JsonString(record.container)
+            << ", \"operation\": " << JsonString(record.operation)
+            << ", \"type\": " << JsonString(record.type)
+            << ", \"size\": " << record.size
+            << std::setprecision(6) << std::defaultfloat
+            << ", \"total_ms\": ";
+        WriteJsonNumber(out, record.total_ms);
+        out << ", \"ns_per_element\": ";
+        WriteJsonNumber(out, record.ns_per_element);
+        out << ", \"params\": {";
+        bool first_param = true;
+        for (const auto& [name, value] : record.params) {
+            out << (first_param ? "" : ", ") << JsonString(name) << ": ";
+            WriteJsonNumber(out, value);
+            first_param = false;
+        }
+        out << "}, \"counters_per_element\": {";
+        bool first_counter = true;
+        for (const auto& [name, value] : record.counters) {
+            out << (first_counter ? "" : ", ") << JsonString(name) << ": ";
+            WriteJsonNumber(out, value);
+            first_counter = false;
+        }
+        out << "}}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Не даёт компилятору выбросить вычисления, результат которых не используется
+template <typename T>
+void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Умеренно тяжёлая работа над элементом, чтобы обход не упирался только в память
+std::uint32_t Mix(std::uint32_t value) {
+    for (int i = 0; i < 32; ++i) {
+        value ^= value << 13;
+        value ^= value >> 17;
+        value ^= value << 5;
+    }
+    return value;
+}
+
+// Список из size элементов, узлы которого расположены в куче в случайном порядке
+// относительно порядка обхода: каждый элемент вставляется после случайного уже вставленного
+template <typename Type>
+SingleLinkedList<Type> MakeScatteredList(size_t size, std::uint32_t seed = 42) {
+    SingleLinkedList<Type> list;
+    std::vector<typename SingleLinkedList<Type>::Iterator> positions;
+    positions.reserve(size + 1);
+    positions.push_back(list.before_begin());
+    std::mt19937 generator(seed);
+    for (size_t i = 0; i < size; ++i) {
+        std::uniform_int_distribution<size_t> pick(0, positions.size() - 1);
+        positions.push_back(list.InsertAfter(positions[pick(generator)], static_cast<Type>(i)));
+    }
+    return list;
+}
+
+// Элемент заданного размера для замеров на "тяжёлых" типах
+template <size_t Bytes>
+struct Payload {
+    static_assert(Bytes % sizeof(std::uint64_t) == 0);
+
+    Payload() = default;
+    explicit Payload(size_t seed) noexcept {
+        words.fill(static_cast<std::uint64_t>(seed));
+    }
+
+    bool operator==(const Payload& rhs) const noexcept {
+        return words == rhs.words;
+    }
+    bool operator<(const Payload& rhs) const noexcept {
+        return words < rhs.words;
+    }
+
+    std::array<std::uint64_t, Bytes / sizeof(std::uint64_t)> words{};
+};
+
+// Имена типов элементов для отчёта
+template <typename T> const char* TypeName();
+template <> const char* TypeName<int>() {return "int";}
+template <> const char* TypeName<Payload<16>>() {return "bytes16";}
+template <> const char* TypeName<Payload<64>>() {return "bytes64";}
+template <> const char* TypeName<Payload<256>>() {return "bytes256";}
+
+template <typename T>
+T MakeValue(size_t i) {
+    return T(i);
+}
+
+template <>
+int MakeValue<int>(size_t i) {
+    return static_cast<int>(i);
+}
+
+// Единообразный доступ к операциям сравниваемых контейнеров.
+// У std::vector роль "начала" играет конец массива (push_back/pop_back), а вставка и удаление
+// после каждого элемента выполняются идиоматичным для вектора проходом за O(N)
+template <typename Container>
+struct ContainerOps;
+
+template <typename T>
+struct ContainerOps<SingleLinkedList<T>> {
+    static const char* Name() {return "SingleLinkedList";}
+    static void PushFront(SingleLinkedList<T>& c, const T& value) {c.PushFront(value);}
+    static void PopFront(SingleLinkedList<T>& c) {c.PopFront();}
+    static void Clear(SingleLinkedList<T>& c) {c.Clear();}
+
+    // Вставляет копию каждого элемента после него самого
+    static void InsertAfterEach(SingleLinkedList<T>& c) {
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            it = c.InsertAfter(it, *it);
+        }
+    }
+    // Удаляет каждый второй элемент
+    static void EraseAfterEach(SingleLinkedList<T>& c) {
+        for (auto it = c.begin(); it != c.end() && std::next(it) != c.end();) {
+            it = c.EraseAfter(it);
+        }
+    }
+};
+
+template <typename T>
+struct ContainerOps<std::forward_list<T>> {
+    static const char* Name() {return "std::forward_list";}
+    static void PushFront(std::forward_list<T>& c, const T& value) {c.push_front(value);}
+    static void PopFront(std::forward_list<T>& c) {c.pop_front();}
+    static void Clear(std::forward_list<T>& c) {c.clear();}
+
+    static void InsertAfterEach(std::forward_list<T>& c) {
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            it = c.insert_after(it, *it);
+        }
+    }
+    static void EraseAfterEach(std::forward_list<T>& c) {
+        for (auto it = c.begin(); it != c.end() && std::next(it) != c.end();) {
+            it = c.erase_after(it);
+        }
+    }
+};
+
+template <typename T>
+struct ContainerOps<std::vector<T>> {
+    static const char* Name() {return "std::vector";}
+    static void PushFront(std::vector<T>& c, const T& value) {c.push_back(value);}
+    static void PopFront(std::vector<T>& c) {c.pop_back();}
+    static void Clear(std::vector<T>& c) {c.clear();}
+
+    static void InsertAfterEach(std::vector<T>& c) {
+        std::vector<T> result;
+        result.reserve(c.size() * 2);
+        for (const T& value : c) {
+            result.push_back(value);
+            result.push_back(value);
+        }
+        c.swap(result);
+    }
+    static void EraseAfterEach(std::vector<T>& c) {
+        size_t index = 0;
+        c.erase(std::remove_if(c.begin(), c.end(), [&index](const T&) { return index++ % 2 == 1; }), c.end());
+    }
+};
+
+// Контейнер из size элементов; у всех контейнеров элементы идут в одном порядке
+template <typename Container>
+Container MakeContainer(size_t size) {
+    using T = typename Container::value_type;
+    Container c;
+    for (size_t i = size; i-- > 0;) {
+        ContainerOps<Container>::PushFront(c, MakeValue<T>(i));
+    }
+    return c;
+}
+
+// Замеряет операцию op над batch подготовленными контейнерами размера size.
+// Подготовка (prepare) в замер не входит
+template <typename Container, typename Prepare, typename Op>
+void MeasureOperation(BenchmarkReport& report, const char* operation, size_t size, size_t batch,
+                      Prepare prepare, Op op) {
+    using T = typename Container::value_type;
+    Measurement best;
+    const int repeats = 3;
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+        std::vector<Container> inputs;
+        inputs.reserve(batch);
+        for (size_t i = 0; i < batch; ++i) {
+            inputs.push_back(prepare());
+        }
+        report.StartCounters();
+        const auto start = Clock::now();
+        for (Container& input : inputs) {
+            op(input);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        auto counters = report.StopCounters();
+        if (repeat == 0 || elapsed.count() < best.ms) {
+            best.ms = elapsed.count();
+            best.counters = std::move(counters);
+        }
+    }
+    const size_t elements = batch * std::max<size_t>(size, 1);
+    BenchmarkRecord record;
+    record.group = "operations";
+    record.container = ContainerOps<Container>::Name();
+    record.operation = operation;
+    record.type = TypeName<T>();
+    record.size = size;
+    record.total_ms = best.ms / batch;
+    record.ns_per_element = best.ms * 1e6 / static_cast<double>(elements);
+    record.counters = PerElement(std::move(best.counters), elements);
+    report.Add(std::move(record));
+}
+
+// Количество контейнеров, обрабатываемых за один замер: маленькие контейнеры
+// обрабатываются пачками, чтобы замер не тонул в погрешности таймера
+size_t BatchFor(size_t size) {
+    return std::max<size_t>(1, (size_t{1} << 16) / std::max<size_t>(size, 1));
+}
+
+// Все операции над контейнером одного типа и размера
+template <typename Container>
+void BenchmarkContainerOperations(BenchmarkReport& report, size_t size) {
+    using T = typename Container::value_type;
+    using Ops = ContainerOps<Container>;
+
+    const size_t batch = BatchFor(size);
+    const auto empty = [] { return Container{}; };
+    const auto filled = [size] { return MakeContainer<Container>(size); };
+    const Container source = MakeContainer<Container>(size);
+    const Container same = MakeContainer<Container>(size);
+
+    MeasureOperation<Container>(report, "PushFront", size, batch, empty, [size](Container& c) {
+        for (size_t i = 0; i < size; ++i) {
+            Ops::PushFront(c, MakeValue<T>(i));
+        }
+    });
+    MeasureOperation<Container>(report, "PopFront", size, batch, filled, [size](Container& c) {
+        for (size_t i = 0; i < size; ++i) {
+            Ops::PopFront(c);
+        }
+    });
+    MeasureOperation<Container>(report, "InsertAfter", size, batch, filled, [](Container& c) {
+        Ops::InsertAfterEach(c);
+    });
+    MeasureOperation<Container>(report, "EraseAfter", size, batch, filled, [](Container& c) {
+        Ops::EraseAfterEach(c);
+    });
+    MeasureOperation<Container>(report, "Iteration", size, batch, empty, [&source](Container&) {
+        size_t count = 0;
+        for (const T& value : source) {
+            DoNotOptimize(value);
+            ++count;
+        }
+        DoNotOptimize(count);
+    });
+    MeasureOperation<Container>(report, "CopyConstruct", size, batch, empty, [&source](Container& c) {
+        Container copy(source);
+        c.swap(copy);
+    });
+    MeasureOperation<Container>(report, "operator=", size, batch, filled, [&source](Container& c) {
+        c = source;
+    });
+    MeasureOperation<Container>(report, "Clear", size, batch, filled, [](Container& c) {
+        Ops::Clear(c);
+    });
+    MeasureOperation<Container>(report, "operator==", size, batch, empty, [&source, &same](Container&) {
+        DoNotOptimize(source == same);
+    });
+    MeasureOperation<Container>(report, "operator<", size, batch, empty, [&source, &same](Container&) {
+        DoNotOptimize(source < same);
+    });
+}
+
+template <typename T>
+void BenchmarkOperationsForType(BenchmarkReport& report, const BenchmarkOptions& options) {
+    for (size_t size = 10; size <= options.max_size; size *= 10) {
+        // Оценка памяти: пачка входных контейнеров, их копии и два эталонных контейнера
+        const size_t bytes_per_element = sizeof(T) + 4 * sizeof(void*);
+        if (size * bytes_per_element * (2 * BatchFor(size) + 2) > options.max_bytes) {
+            std::cout << "  skipping " << TypeName<T>() << " x " << size << ": exceeds --max-bytes" << std::endl;
+            break;
+        }
+        BenchmarkContainerOperations<SingleLinkedList<T>>(report, size);
+        BenchmarkContainerOperations<std::forward_list<T>>(report, size);
+        BenchmarkContainerOperations<std::vector<T>>(report, size);
+    }
+}
+
+void BenchmarkOperations(BenchmarkReport& report, const BenchmarkOptions& options) {
+    std::cout << "Operations of SingleLinkedList, std::forward_list and std::vector" << std::endl;
+    BenchmarkOperationsForType<int>(report, options);
+    BenchmarkOperationsForType<Payload<16>>(report, options);
+    BenchmarkOperationsForType<Payload<64>>(report, options);
+    BenchmarkOperationsForType<Payload<256>>(report, options);
+}
+
+// Запись о замере одного из специализированных бенчмарков
+BenchmarkRecord MakeRecord(const char* group, const char* container, const char* operation,
+                           const char* type, size_t size, const Measurement& measurement) {
+    BenchmarkRecord record;
+    record.group = group;
+    record.container = container;
+    record.operation = operation;
+    record.type = type;
+    record.size = size;
+    record.total_ms = measurement.ms;
+    record.ns_per_element = measurement.ms * 1e6 / std::max<size_t>(size, 1);
+    record.counters = PerElement(measurement.counters, size);
+    return record;
+}
+
+void BenchmarkParallelScaling(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 22;
+    SingleLinkedList<std::uint32_t> list;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(static_cast<std::uint32_t>(i));
+    }
+
+    std::vector<size_t> thread_counts{1};
+    const size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 2; threads <= max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    if (thread_counts.back() != max_threads) {
+        thread_counts.push_back(max_threads);
+    }
+
+    std::cout << "ParallelForEach / ParallelReduce / ParallelCount scaling" << std::endl;
+    double base_for_each = 0.0;
+    for (size_t threads : thread_counts) {
+        ParallelExecutor executor(threads);
+        const auto for_each_time = report.Measure([&] {
+            ParallelForEach(list, [](std::uint32_t& value) { value = Mix(value); }, executor);
+        });
+        const auto reduce_time = report.Measure([&] {
+            DoNotOptimize(ParallelReduce(list, std::uint64_t{0}, std::plus<std::uint64_t>{}, executor));
+        });
+        const auto count_time = report.Measure([&] {
+            DoNotOptimize(ParallelCount(list, [](std::uint32_t value) { return Mix(value) % 3 == 0; }, executor));
+        });
+        if (threads == 1) {
+            base_for_each = for_each_time.ms;
+        }
+        const double threads_param = static_cast<double>(threads);
+        auto for_each = MakeRecord("parallel", "ParallelForEach", "ForEach", "uint32", size, for_each_time);
+        for_each.params = {{"threads", threads_param}, {"speedup", base_for_each / for_each_time.ms}};
+        report.Add(std::move(for_each));
+        auto reduce = MakeRecord("parallel", "ParallelReduce", "Reduce", "uint32", size, reduce_time);
+        reduce.params = {{"threads", threads_param}};
+        report.Add(std::move(reduce));
+        auto count = MakeRecord("parallel", "ParallelCount", "Count", "uint32", size, count_time);
+        count.params = {{"threads", threads_param}};
+        report.Add(std::move(count));
+    }
+}
+
+void BenchmarkPrefetchedTraversal(BenchmarkReport& report, const BenchmarkOptions&) {
+    // 8M узлов по 16 байт - заведомо больше кэша последнего уровня
+    const size_t size = 1 << 23;
+    const auto list = MakeScatteredList<std::uint64_t>(size);
+
+    std::cout << "Traversal of a scattered list with and without prefetching" << std::endl;
+    const auto plain_time = report.Measure([&] {
+        std::uint64_t sum = 0;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            sum += Mix(static_cast<std::uint32_t>(*it)) & 0xFF;
+        }
+        DoNotOptimize(sum);
+    });
+    report.Add(MakeRecord("prefetch", "BasicIterator", "Traversal", "uint64", size, plain_time));
+    for (size_t distance : {2u, 4u, 8u, 16u, 32u}) {
+        const auto prefetched_time = report.Measure([&] {
+            std::uint64_t sum = 0;
+            ForEachPrefetched(list, [&sum](std::uint64_t value) {
+                sum += Mix(static_cast<std::uint32_t>(value)) & 0xFF;
+            }, distance);
+            DoNotOptimize(sum);
+        });
+        auto record = MakeRecord("prefetch", "ForEachPrefetched", "Traversal", "uint64", size, prefetched_time);
+        record.params = {{"distance", static_cast<double>(distance)},
+                         {"speedup", plain_time.ms / prefetched_time.ms}};
+        report.Add(std::move(record));
+    }
+}
+
+void BenchmarkBatchFind(BenchmarkReport& report, const BenchmarkOptions&) {
+    // Хэш-таблица из коротких цепочек: узлы корзин разбросаны по куче вперемешку
+    const size_t buckets_count = 1 << 20;
+    const size_t elements = 4 * buckets_count;
+    std::vector<SingleLinkedList<std::uint64_t>> buckets(buckets_count);
+    std::mt19937_64 generator(7);
+    for (size_t i = 0; i < elements; ++i) {
+        const std::uint64_t key = generator();
+        buckets[key % buckets_count].PushFront(key);
+    }
+
+    // Пакеты запросов к случайным корзинам. Ключ отсутствует, поэтому каждая цепочка проходится целиком
+    const size_t batch_size = 4096;
+    const size_t batches = 64;
+    std::vector<std::vector<const SingleLinkedList<std::uint64_t>*>> batch_lists(batches);
+    for (auto& lists : batch_lists) {
+        for (size_t i = 0; i < batch_size; ++i) {
+            lists.push_back(&buckets[generator() % buckets_count]);
+        }
+    }
+    const std::uint64_t key = 12345;
+    const size_t lookups = batches * batch_size;
+
+    std::cout << "Batch lookups over short scattered lists" << std::endl;
+    const auto sequential_time = report.Measure([&] {
+        size_t found = 0;
+        for (const auto& lists : batch_lists) {
+            for (const auto* list : lists) {
+                found += std::find(list->begin(), list->end(), key) != list->end();
+            }
+        }
+        DoNotOptimize(found);
+    });
+    report.Add(MakeRecord("batch_find", "std::find", "Lookup", "uint64", lookups, sequential_time));
+    for (size_t group : {4u, 8u, 16u, 32u}) {
+        const auto batched_time = report.Measure([&] {
+            size_t found = 0;
+            for (const auto& lists : batch_lists) {
+                const auto result = FindInEach(lists, key, group);
+                for (size_t i = 0; i < lists.size(); ++i) {
+                    found += result[i] != lists[i]->end();
+                }
+            }
+            DoNotOptimize(found);
+        });
+        auto record = MakeRecord("batch_find", "FindInEach", "Lookup", "uint64", lookups, batched_time);
+        record.params = {{"group", static_cast<double>(group)}, {"speedup", sequential_time.ms / batched_time.ms}};
+        report.Add(std::move(record));
+    }
+}
+
+void BenchmarkCompaction(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 22;
+    auto list = MakeScatteredList<std::uint64_t>(size);
+    const auto traverse = [&list] {
+        DoNotOptimize(std::accumulate(list.begin(), list.end(), std::uint64_t{0}));
+    };
+
+    std::cout << "Traversal before and after Compact" << std::endl;
+    const auto scattered_time = report.Measure(traverse);
+    report.Add(MakeRecord("compaction", "scattered", "Traversal", "uint64", size, scattered_time));
+    SingleLinkedList<std::uint64_t>::CompactionResult result;
+    auto compaction = MakeRecord("compaction", "SingleLinkedList", "Compact", "uint64", size,
+                                 report.Measure([&] { result = list.Compact(); }, 1));
+    compaction.params = {{"bytes_reclaimed", static_cast<double>(result.GetBytesReclaimed())}};
+    report.Add(std::move(compaction));
+    const auto compact_time = report.Measure(traverse);
+    auto compact = MakeRecord("compaction", "compact", "Traversal", "uint64", size, compact_time);
+    compact.params = {{"speedup", scattered_time.ms / compact_time.ms}};
+    report.Add(std::move(compact));
+}
+
+void BenchmarkEquality(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 21;
+    auto lhs = MakeScatteredList<std::uint64_t>(size);
+    auto rhs = MakeScatteredList<std::uint64_t>(size);
+    const auto compare = [&] {
+        DoNotOptimize(lhs == rhs);
+    };
+
+    std::cout << "Equality of scattered and compacted lists" << std::endl;
+    const auto scattered_time = report.Measure(compare);
+    report.Add(MakeRecord("equality", "scattered", "operator==", "uint64", size, scattered_time));
+    lhs.Compact();
+    rhs.Compact();
+    const auto compact_time = report.Measure(compare);
+    auto compact = MakeRecord("equality", "compact", "operator==", "uint64", size, compact_time);
+    compact.params = {{"speedup", scattered_time.ms / compact_time.ms}};
+    report.Add(std::move(compact));
+    rhs.PopFront();
+    report.Add(MakeRecord("equality", "size mismatch", "operator==", "uint64", size, report.Measure(compare)));
+}
+
+// Сколько байт приходится на элемент списка: в куче по одному узлу и после уплотнения
+template <typename Type, typename MakeValueFunc>
+void BenchmarkMemoryFootprintFor(BenchmarkReport& report, const char* type, size_t size, MakeValueFunc make_value) {
+    SingleLinkedList<Type> list;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(make_value(i));
+    }
+    const auto add_record = [&](const char* container) {
+        ListMemoryUsage usage;
+        auto record = MakeRecord("memory", container, "MemoryUsage", type, size,
+                                 report.Measure([&] { usage = list.MemoryUsage(); }, 1));
+        const double elements = static_cast<double>(std::max<size_t>(size, 1));
+        record.params = {
+            {"bytes_per_element", usage.GetBytesPerElement()},
+            {"value_size", static_cast<double>(sizeof(Type))},
+            {"node_size", static_cast<double>(usage.node_size)},
+            {"node_padding", static_cast<double>(usage.node_padding)},
+            {"allocator_overhead", static_cast<double>(usage.allocator_overhead) / elements},
+            {"value_heap", static_cast<double>(usage.value_heap_bytes) / elements},
+        };
+        report.Add(std::move(record));
+    };
+    add_record("SingleLinkedList");
+    list.Compact();
+    add_record("compacted");
+}
+
+void BenchmarkMemoryFootprint(BenchmarkReport& report, const BenchmarkOptions& options) {
+    const size_t size = std::min<size_t>(options.max_size, 1 << 16);
+    std::cout << "Memory footprint per element" << std::endl;
+    BenchmarkMemoryFootprintFor<char>(report, "char", size, [](size_t i) { return static_cast<char>(i); });
+    BenchmarkMemoryFootprintFor<int>(report, "int", size, MakeValue<int>);
+    BenchmarkMemoryFootprintFor<std::uint64_t>(report, "uint64", size, [](size_t i) { return std::uint64_t{i}; });
+    BenchmarkMemoryFootprintFor<Payload<16>>(report, "bytes16", size, MakeValue<Payload<16>>);
+    BenchmarkMemoryFootprintFor<Payload<64>>(report, "bytes64", size, MakeValue<Payload<64>>);
+    BenchmarkMemoryFootprintFor<Payload<256>>(report, "bytes256", size, MakeValue<Payload<256>>);
+    BenchmarkMemoryFootprintFor<std::string>(report, "string8", size, [](size_t i) {
+        return std::string(8, static_cast<char>('a' + i % 26));
+    });
+    BenchmarkMemoryFootprintFor<std::string>(report, "string64", size, [](size_t i) {
+        return std::string(64, static_cast<char>('a' + i % 26));
+    });
+}
+
+void BenchmarkHashing(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 21;
+    auto list = MakeScatteredList<std::uint64_t>(size);
+    auto cached = MakeScatteredList<std::int64_t>(size);
+    const auto hash_list = [&] {
+        DoNotOptimize(std::hash<SingleLinkedList<std::uint64_t>>{}(list));
+    };
+
+    std::cout << "Hashing of whole lists" << std::endl;
+    const auto scattered_time = report.Measure(hash_list);
+    report.Add(MakeRecord("hashing", "scattered", "GetHash", "uint64", size, scattered_time));
+    list.Compact();
+    const auto compact_time = report.Measure(hash_list);
+    auto compact = MakeRecord("hashing", "compact", "GetHash", "uint64", size, compact_time);
+    compact.params = {{"speedup", scattered_time.ms / compact_time.ms}};
+    report.Add(std::move(compact));
+
+    // Повторный хэш неизменённого списка и хэш после PushFront берутся из кэша
+    DoNotOptimize(cached.GetHash());
+    const auto cached_time = report.Measure([&] {
+        cached.PushFront(1);
+        DoNotOptimize(cached.GetHash());
+        cached.PopFront();
+        DoNotOptimize(cached.GetHash());
+    });
+    auto record = MakeRecord("hashing", "cached", "Rehash", "int64", size, cached_time);
+    record.params = {{"speedup", scattered_time.ms / cached_time.ms}};
+    report.Add(std::move(record));
+}
+
+// Пропускная способность Serialize/Deserialize через буфер в памяти
+template <typename Type, typename MakeValueFunc>
+void BenchmarkSerializationFor(BenchmarkReport& report, const char* type, size_t size, MakeValueFunc make_value) {
+    SingleLinkedList<Type> list;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(make_value(i));
+    }
+    std::vector<char> buffer;
+    const auto serialize = [&] {
+        buffer.clear();
+        ListByteWriter writer(buffer);
+        list.Serialize(writer);
+    };
+    serialize();
+    const double gigabytes = static_cast<double>(buffer.size()) / 1e9;
+
+    auto serialized = MakeRecord("serialization", "SingleLinkedList", "Serialize", type, size,
+                                 report.Measure(serialize));
+    serialized.params = {{"bytes", static_cast<double>(buffer.size())},
+                         {"gb_per_s", gigabytes / (serialized.total_ms / 1e3)}};
+    report.Add(std::move(serialized));
+
+    auto deserialized = MakeRecord("serialization", "SingleLinkedList", "Deserialize", type, size,
+                                   report.Measure([&] {
+        ListByteReader reader(buffer.data(), buffer.size());
+        DoNotOptimize(SingleLinkedList<Type>::Deserialize(reader).GetSize());
+    }));
+    deserialized.params = {{"bytes", static_cast<double>(buffer.size())},
+                           {"gb_per_s", gigabytes / (deserialized.total_ms / 1e3)}};
+    report.Add(std::move(deserialized));
+
+    // Потоковое чтение: в памяти одновременно не больше одной части
+    auto streamed = MakeRecord("serialization", "ListStreamReader", "ForEach", type, size, report.Measure([&] {
+        ListByteReader reader(buffer.data(), buffer.size());
+        ListStreamReader<Type> stream(reader);
+        size_t count = 0;
+        stream.ForEach([&count](Type&& value) {
+            DoNotOptimize(value);
+            ++count;
+        });
+        DoNotOptimize(count);
+    }));
+    streamed.params = {{"chunk", static_cast<double>(kDefaultStreamChunkSize)},
+                       {"gb_per_s", gigabytes / (streamed.total_ms / 1e3)}};
+    report.Add(std::move(streamed));
+}
+
+void BenchmarkSerialization(BenchmarkReport& report, const BenchmarkOptions&) {
+    std::cout << "Binary serialization throughput" << std::endl;
+    BenchmarkSerializationFor<std::uint64_t>(report, "uint64", 1 << 22, [](size_t i) { return std::uint64_t{i}; });
+    BenchmarkSerializationFor<Payload<256>>(report, "bytes256", 1 << 18, MakeValue<Payload<256>>);
+    BenchmarkSerializationFor<std::string>(report, "string64", 1 << 19, [](size_t i) {
+        return std::string(64, static_cast<char>('a' + i % 26));
+    });
+}
+
+void BenchmarkMappedStartup(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 22;
+    SingleLinkedList<std::uint64_t> list;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(i);
+    }
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string serialized_path = (directory / "sll_bench_serialized.bin").string();
+    const std::string mapped_path = (directory / "sll_bench_mapped.bin").string();
+    {
+        std::ofstream out(serialized_path, std::ios::binary | std::ios::trunc);
+        list.Serialize(out);
+    }
+    MappedSingleLinkedList<std::uint64_t>::Write(list, mapped_path);
+
+    // Запуск: список готов к обходу, из него прочитан первый элемент
+    std::cout << "Startup from a serialized file vs a memory-mapped view" << std::endl;
+    const auto deserialize_time = report.Measure([&] {
+        std::ifstream in(serialized_path, std::ios::binary);
+        const auto restored = SingleLinkedList<std::uint64_t>::Deserialize(in);
+        DoNotOptimize(*restored.begin());
+    });
+    report.Add(MakeRecord("mapped", "Deserialize", "Startup", "uint64", size, deserialize_time));
+    const auto open_time = report.Measure([&] {
+        const auto mapped = MappedSingleLinkedList<std::uint64_t>::Open(mapped_path);
+        DoNotOptimize(*mapped.begin());
+    });
+    auto open = MakeRecord("mapped", "MappedSingleLinkedList", "Startup", "uint64", size, open_time);
+    open.params = {{"speedup", deserialize_time.ms / open_time.ms}};
+    report.Add(std::move(open));
+
+    const auto mapped = MappedSingleLinkedList<std::uint64_t>::Open(mapped_path);
+    report.Add(MakeRecord("mapped", "MappedSingleLinkedList", "Traversal", "uint64", size, report.Measure([&] {
+        DoNotOptimize(std::accumulate(mapped.begin(), mapped.end(), std::uint64_t{0}));
+    })));
+    report.Add(MakeRecord("mapped", "SingleLinkedList", "Traversal", "uint64", size, report.Measure([&] {
+        DoNotOptimize(std::accumulate(list.begin(), list.end(), std::uint64_t{0}));
+    })));
+    std::filesystem::remove(serialized_path);
+    std::filesystem::remove(mapped_path);
+}
+
+void BenchmarkSnapshots(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 20;
+    const size_t snapshots = 64;
+    SingleLinkedList<std::uint64_t> list;
+    PersistentSingleLinkedList<std::uint64_t> persistent;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(i);
+        persistent = persistent.PushFront(i);
+    }
+
+    // Снимок на каждый запрос, затем изменение начала списка
+    std::cout << "Snapshots: copy constructor vs persistent versions" << std::endl;
+    const auto copy_time = report.Measure([&] {
+        for (size_t i = 0; i < snapshots; ++i) {
+            const SingleLinkedList<std::uint64_t> snapshot(list);
+            list.PushFront(i);
+            list.PopFront();
+            DoNotOptimize(snapshot.GetSize());
+        }
+    }, 1);
+    auto copy = MakeRecord("snapshots", "SingleLinkedList", "Snapshot", "uint64", snapshots, copy_time);
+    copy.params = {{"list_size", static_cast<double>(size)}};
+    report.Add(std::move(copy));
+    const auto persistent_time = report.Measure([&] {
+        for (size_t i = 0; i < snapshots; ++i) {
+            const PersistentSingleLinkedList<std::uint64_t> snapshot = persistent;
+            persistent = persistent.PushFront(i).PopFront();
+            DoNotOptimize(snapshot.GetSize());
+        }
+    });
+    auto versions = MakeRecord("snapshots", "PersistentSingleLinkedList", "Snapshot", "uint64", snapshots,
+                               persistent_time);
+    versions.params = {{"list_size", static_cast<double>(size)}, {"speedup", copy_time.ms / persistent_time.ms}};
+    report.Add(std::move(versions));
+}
+
+void BenchmarkCopyOnWrite(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 18;
+    const size_t readers = 16;
+    const size_t insert_position = 64;
+    SingleLinkedList<std::uint64_t> list;
+    CowSingleLinkedList<std::uint64_t> cow;
+    for (size_t i = 0; i < size; ++i) {
+        list.PushFront(i);
+        cow.PushFront(i);
+    }
+
+    // Каждый читатель получает копию и обходит её; затем писатель вставляет элемент недалеко от начала
+    std::cout << "Copy-on-write: copies for readers, then one insert near the front" << std::endl;
+    const auto copy_time = report.Measure([&] {
+        std::vector<SingleLinkedList<std::uint64_t>> copies(readers, list);
+        std::uint64_t sum = 0;
+        for (const auto& copy : copies) {
+            sum += std::accumulate(copy.begin(), copy.end(), std::uint64_t{0});
+        }
+        list.InsertAfter(std::next(list.cbegin(), insert_position), sum);
+        list.EraseAfter(std::next(list.cbegin(), insert_position));
+        DoNotOptimize(sum);
+    }, 1);
+    auto copy = MakeRecord("cow", "SingleLinkedList", "CopyAndRead", "uint64", readers * size, copy_time);
+    copy.params = {{"list_size", static_cast<double>(size)}, {"readers", static_cast<double>(readers)}};
+    report.Add(std::move(copy));
+    const auto cow_time = report.Measure([&] {
+        std::vector<CowSingleLinkedList<std::uint64_t>> copies(readers, cow);
+        std::uint64_t sum = 0;
+        for (const auto& copy : copies) {
+            sum += std::accumulate(copy.begin(), copy.end(), std::uint64_t{0});
+        }
+        cow.InsertAfter(std::next(cow.cbegin(), insert_position), sum);
+        cow.EraseAfter(std::next(cow.cbegin(), insert_position));
+        DoNotOptimize(sum);
+    }, 1);
+    auto shared = MakeRecord("cow", "CowSingleLinkedList", "CopyAndRead", "uint64", readers * size, cow_time);
+    shared.params = {{"list_size", static_cast<double>(size)}, {"readers", static_cast<double>(readers)},
+                     {"speedup", copy_time.ms / cow_time.ms}};
+    report.Add(std::move(shared));
+}
+
+void BenchmarkPositional(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 18;
+    const size_t queries = 1024;
+    SingleLinkedList<std::uint64_t> plain;
+    SingleLinkedList<long long> indexed;
+    for (size_t i = 0; i < size; ++i) {
+        plain.PushFront(i);
+        indexed.PushFront(static_cast<long long>(i));
+    }
+    std::mt19937_64 generator(11);
+    std::vector<size_t> positions(queries);
+    std::vector<size_t> distances(queries);
+    for (size_t i = 0; i < queries; ++i) {
+        positions[i] = generator() % size;
+        distances[i] = generator() % (size - positions[i]);
+    }
+
+    // Случайные номера элементов и переходы на случайное расстояние от случайного элемента
+    std::cout << "Positional access: At and Advance with and without the position index" << std::endl;
+    const auto measure = [&](const auto& list) {
+        (void)list.At(0);   // Индекс строится при первом позиционном запросе
+        const auto at_time = report.Measure([&] {
+            std::uint64_t sum = 0;
+            for (size_t position : positions) {
+                sum += static_cast<std::uint64_t>(list.At(position));
+            }
+            DoNotOptimize(sum);
+        }, 1);
+        const auto advance_time = report.Measure([&] {
+            std::uint64_t sum = 0;
+            for (size_t i = 0; i < queries; ++i) {
+                const auto it = list.Advance(list.IteratorAt(positions[i]), distances[i]);
+                sum += static_cast<std::uint64_t>(*it);
+            }
+            DoNotOptimize(sum);
+        }, 1);
+        return std::make_pair(at_time, advance_time);
+    };
+    const auto [plain_at, plain_advance] = measure(plain);
+    report.Add(MakeRecord("positional", "SingleLinkedList", "At", "uint64", queries, plain_at));
+    report.Add(MakeRecord("positional", "SingleLinkedList", "Advance", "uint64", queries, plain_advance));
+    const auto [indexed_at, indexed_advance] = measure(indexed);
+    auto at = MakeRecord("positional", "SingleLinkedList+index", "At", "int64", queries, indexed_at);
+    at.params = {{"list_size", static_cast<double>(size)}, {"speedup", plain_at.ms / indexed_at.ms}};
+    report.Add(std::move(at));
+    auto advance = MakeRecord("positional", "SingleLinkedList+index", "Advance", "int64", queries, indexed_advance);
+    advance.params = {{"list_size", static_cast<double>(size)}, {"speedup", plain_advance.ms / indexed_advance.ms}};
+    report.Add(std::move(advance));
+}
+
+void BenchmarkSorted(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 14;
+    std::mt19937_64 generator(13);
+    std::vector<std::uint64_t> values(size);
+    for (auto& value : values) {
+        value = generator();
+    }
+
+    // Вставка с сохранением порядка: проход от начала до предшественника против поиска по опорным узлам
+    std::cout << "Sorted list: ordered inserts and lookups" << std::endl;
+    SingleLinkedList<std::uint64_t> plain;
+    const auto scan_insert_time = report.Measure([&] {
+        plain.Clear();
+        for (std::uint64_t value : values) {
+            auto prev = plain.cbefore_begin();
+            for (auto next = std::next(prev); next != plain.cend() && *next < value; ++next) {
+                prev = next;
+            }
+            plain.InsertAfter(prev, value);
+        }
+    }, 1);
+    report.Add(MakeRecord("sorted", "SingleLinkedList", "InsertSorted", "uint64", size, scan_insert_time));
+    SortedSingleLinkedList<std::uint64_t> sorted;
+    const auto sorted_insert_time = report.Measure([&] {
+        sorted.Clear();
+        for (std::uint64_t value : values) {
+            sorted.InsertSorted(value);
+        }
+    }, 1);
+    auto insert = MakeRecord("sorted", "SortedSingleLinkedList", "InsertSorted", "uint64", size, sorted_insert_time);
+    insert.params = {{"speedup", scan_insert_time.ms / sorted_insert_time.ms}};
+    report.Add(std::move(insert));
+
+    const auto scan_find_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t value : values) {
+            const auto it = std::find_if(plain.begin(), plain.end(), [value](std::uint64_t x) {return x >= value;});
+            found += it != plain.end() && *it == value;
+        }
+        DoNotOptimize(found);
+    }, 1);
+    report.Add(MakeRecord("sorted", "SingleLinkedList", "Find", "uint64", size, scan_find_time));
+    const auto sorted_find_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t value : values) {
+            found += sorted.Find(value) != sorted.end();
+        }
+        DoNotOptimize(found);
+    });
+    auto find = MakeRecord("sorted", "SortedSingleLinkedList", "Find", "uint64", size, sorted_find_time);
+    find.params = {{"speedup", scan_find_time.ms / sorted_find_time.ms}};
+    report.Add(std::move(find));
+}
+
+void BenchmarkHashIndex(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 16;
+    const size_t queries = 1 << 12;
+    std::mt19937_64 generator(17);
+    SingleLinkedList<std::uint64_t> plain;
+    HashIndexedSingleLinkedList<std::uint64_t> indexed;
+    for (size_t i = 0; i < size; ++i) {
+        const std::uint64_t value = generator() % (2 * size);
+        plain.PushFront(value);
+        indexed.PushFront(value);
+    }
+    std::vector<std::uint64_t> probes(queries);
+    for (auto& probe : probes) {
+        probe = generator() % (2 * size);
+    }
+
+    // Проверки принадлежности (примерно половина значений есть в списке), затем удаление по значению
+    std::cout << "Hash index: membership tests and erase by value" << std::endl;
+    const auto scan_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t probe : probes) {
+            found += std::find(plain.begin(), plain.end(), probe) != plain.end();
+        }
+        DoNotOptimize(found);
+    }, 1);
+    report.Add(MakeRecord("hash_index", "SingleLinkedList", "Contains", "uint64", queries, scan_time));
+    const auto indexed_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t probe : probes) {
+            found += indexed.Contains(probe);
+        }
+        DoNotOptimize(found);
+    });
+    auto contains = MakeRecord("hash_index", "HashIndexedSingleLinkedList", "Contains", "uint64", queries,
+                               indexed_time);
+    contains.params = {{"list_size", static_cast<double>(size)}, {"speedup", scan_time.ms / indexed_time.ms}};
+    report.Add(std::move(contains));
+
+    const auto scan_erase_time = report.Measure([&] {
+        size_t erased = 0;
+        for (std::uint64_t probe : probes) {
+            for (auto prev = plain.cbefore_begin(); std::next(prev) != plain.cend();) {
+                if (*std::next(prev) == probe) {
+                    plain.EraseAfter(prev);
+                    ++erased;
+                } else {
+                    ++prev;
+                }
+            }
+        }
+        DoNotOptimize(erased);
+    }, 1);
+    report.Add(MakeRecord("hash_index", "SingleLinkedList", "EraseValue", "uint64", queries, scan_erase_time));
+    const auto indexed_erase_time = report.Measure([&] {
+        size_t erased = 0;
+        for (std::uint64_t probe : probes) {
+            erased += indexed.EraseValue(probe);
+        }
+        DoNotOptimize(erased);
+    }, 1);
+    auto erase = MakeRecord("hash_index", "HashIndexedSingleLinkedList", "EraseValue", "uint64", queries,
+                            indexed_erase_time);
+    erase.params = {{"list_size", static_cast<double>(size)}, {"speedup", scan_erase_time.ms / indexed_erase_time.ms}};
+    report.Add(std::move(erase));
+}
+
+// Кэш той же ёмкости на std::list и std::unordered_map - распространённая реализация LRU для сравнения
+class StdLruCache {
+public:
+    explicit StdLruCache(size_t capacity) : capacity_(capacity) {
+        positions_.reserve(capacity);
+    }
+
+    [[nodiscard]] std::uint64_t* Get(std::uint64_t key) {
+        const auto it = positions_.find(key);
+        if (it == positions_.end()) {
+            return nullptr;
+        }
+        order_.splice(order_.begin(), order_, it->second);
+        return &it->second->second;
+    }
+
+    void Put(std::uint64_t key, std::uint64_t value) {
+        if (order_.size() == capacity_) {
+            positions_.erase(order_.back().first);
+            order_.pop_back();
+        }
+        order_.emplace_front(key, value);
+        positions_.emplace(key, order_.begin());
+    }
+
+private:
+    size_t capacity_;
+    std::list<std::pair<std::uint64_t, std::uint64_t>> order_;
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, std::uint64_t>>::iterator> positions_;
+};
+
+// Обращения "прочитать, при промахе записать" с перекошенным распределением ключей:
+// небольшая доля ключей получает большую часть обращений, как в типичной нагрузке на кэш
+void BenchmarkLru(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t capacity = 1 << 14;
+    const size_t key_space = 1 << 18;
+    const size_t accesses = 1 << 21;
+    std::mt19937_64 generator(19);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::uint64_t> keys(accesses);
+    for (auto& key : keys) {
+        const double u = uniform(generator);
+        key = static_cast<std::uint64_t>(static_cast<double>(key_space) * u * u * u * u);
+    }
+
+    std::cout << "LRU cache: get, put on miss; skewed keys" << std::endl;
+    double std_hit_rate = 0.0;
+    const auto std_time = report.Measure([&] {
+        StdLruCache cache(capacity);
+        size_t hits = 0;
+        for (std::uint64_t key : keys) {
+            if (cache.Get(key) != nullptr) {
+                ++hits;
+            } else {
+                cache.Put(key, key);
+            }
+        }
+        std_hit_rate = static_cast<double>(hits) / static_cast<double>(accesses);
+    });
+    auto std_record = MakeRecord("lru", "std::list+map", "GetOrPut", "uint64", accesses, std_time);
+    std_record.params = {{"capacity", static_cast<double>(capacity)}, {"hit_rate", std_hit_rate}};
+    report.Add(std::move(std_record));
+
+    double hit_rate = 0.0;
+    const auto lru_time = report.Measure([&] {
+        LruCache<std::uint64_t, std::uint64_t> cache(capacity);
+        for (std::uint64_t key : keys) {
+            if (cache.Get(key) == nullptr) {
+                cache.Put(key, key);
+            }
+        }
+        hit_rate = cache.GetStats().GetHitRate();
+    });
+    auto lru_record = MakeRecord("lru", "LruCache", "GetOrPut", "uint64", accesses, lru_time);
+    lru_record.params = {{"capacity", static_cast<double>(capacity)}, {"hit_rate", hit_rate},
+                         {"speedup", std_time.ms / lru_time.ms}};
+    report.Add(std::move(lru_record));
+}
+
+// Таблица с цепочками, где каждая корзина - целый SingleLinkedList (для сравнения с LinkedHashMap)
+class ListBucketHashMap {
+public:
+    using Bucket = SingleLinkedList<std::pair<std::uint64_t, std::uint64_t>>;
+
+    void Insert(std::uint64_t key, std::uint64_t value) {
+        if (size_ >= buckets_.size()) {
+            Rehash(std::max<size_t>(buckets_.size() * 2, 8));
+        }
+        buckets_[BucketIndex(key)].PushFront({key, value});
+        ++size_;
+    }
+
+    [[nodiscard]] const std::uint64_t* Find(std::uint64_t key) const {
+        const Bucket& bucket = buckets_[BucketIndex(key)];
+        const auto it = std::find_if(bucket.begin(), bucket.end(), [key](const auto& entry) {
+            return entry.first == key;
+        });
+        return it == bucket.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]] size_t GetBucketCount() const noexcept {return buckets_.size();}
+
+private:
+    std::vector<Bucket> buckets_;
+    size_t size_ = 0;
+
+    [[nodiscard]] size_t BucketIndex(std::uint64_t key) const noexcept {
+        return list_hash_detail::Mix(key) & (buckets_.size() - 1);
+    }
+
+    void Rehash(size_t count) {
+        std::vector<Bucket> buckets(count);
+        buckets_.swap(buckets);
+        for (const Bucket& bucket : buckets) {
+            for (const auto& entry : bucket) {
+                buckets_[BucketIndex(entry.first)].PushFront(entry);
+            }
+        }
+    }
+};
+
+// Построение таблицы и поиск (половина ключей есть в таблице) в LinkedHashMap, таблице со списками-корзинами
+// и std::unordered_map
+void BenchmarkLinkedHashMap(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 18;
+    std::mt19937_64 generator(23);
+    std::vector<std::uint64_t> keys(size);
+    for (auto& key : keys) {
+        key = generator();
+    }
+    std::vector<std::uint64_t> probes(size);
+    for (size_t i = 0; i < size; ++i) {
+        probes[i] = i % 2 == 0 ? keys[generator() % size] : generator();
+    }
+
+    std::cout << "Linked hash map: build and lookup" << std::endl;
+    ListBucketHashMap list_buckets;
+    const auto list_build_time = report.Measure([&] {
+        ListBucketHashMap map;
+        for (std::uint64_t key : keys) {
+            map.Insert(key, key);
+        }
+        list_buckets = std::move(map);
+    });
+    auto list_build = MakeRecord("linked_hash", "SingleLinkedList buckets", "Insert", "uint64", size, list_build_time);
+    list_build.params = {{"bucket_bytes", static_cast<double>(sizeof(ListBucketHashMap::Bucket))}};
+    report.Add(std::move(list_build));
+
+    std::unordered_map<std::uint64_t, std::uint64_t> std_map;
+    const auto std_build_time = report.Measure([&] {
+        std::unordered_map<std::uint64_t, std::uint64_t> map;
+        for (std::uint64_t key : keys) {
+            map.emplace(key, key);
+        }
+        std_map = std::move(map);
+    });
+    report.Add(MakeRecord("linked_hash", "std::unordered_map", "Insert", "uint64", size, std_build_time));
+
+    LinkedHashMap<std::uint64_t, std::uint64_t> linked;
+    const auto linked_build_time = report.Measure([&] {
+        LinkedHashMap<std::uint64_t, std::uint64_t> map;
+        for (std::uint64_t key : keys) {
+            map.Insert(key, key);
+        }
+        linked = std::move(map);
+    });
+    auto linked_build = MakeRecord("linked_hash", "LinkedHashMap", "Insert", "uint64", size, linked_build_time);
+    linked_build.params = {{"bucket_bytes", static_cast<double>(sizeof(void*))},
+                           {"speedup", list_build_time.ms / linked_build_time.ms}};
+    report.Add(std::move(linked_build));
+
+    const auto list_find_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t probe : probes) {
+            found += list_buckets.Find(probe) != nullptr;
+        }
+        DoNotOptimize(found);
+    });
+    report.Add(MakeRecord("linked_hash", "SingleLinkedList buckets", "Find", "uint64", size, list_find_time));
+    const auto std_find_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t probe : probes) {
+            found += std_map.find(probe) != std_map.end();
+        }
+        DoNotOptimize(found);
+    });
+    report.Add(MakeRecord("linked_hash", "std::unordered_map", "Find", "uint64", size, std_find_time));
+    const auto linked_find_time = report.Measure([&] {
+        size_t found = 0;
+        for (std::uint64_t probe : probes) {
+            found += linked.Contains(probe);
+        }
+        DoNotOptimize(found);
+    });
+    auto linked_find = MakeRecord("linked_hash", "LinkedHashMap", "Find", "uint64", size, linked_find_time);
+    linked_find.params = {{"speedup", list_find_time.ms / linked_find_time.ms}};
+    report.Add(std::move(linked_find));
+}
+
+// Заполнение и опустошение короткого списка раз за разом, как у очереди заданий на пути реального времени:
+// SingleLinkedList и std::forward_list обращаются к распределителю памяти на каждый элемент,
+// StaticSingleLinkedList - ни разу
+template <typename List>
+Measurement MeasurePushPopChurn(BenchmarkReport& report, List& list, size_t rounds, size_t depth) {
+    return report.Measure([&] {
+        std::uint64_t sum = 0;
+        for (size_t round = 0; round < rounds; ++round) {
+            for (size_t i = 0; i < depth; ++i) {
+                list.PushFront(static_cast<std::uint64_t>(round + i));
+            }
+            while (!list.IsEmpty()) {
+                sum += *list.begin();
+                list.PopFront();
+            }
+        }
+        DoNotOptimize(sum);
+    });
+}
+
+void BenchmarkStaticList(BenchmarkReport& report, const BenchmarkOptions&) {
+    constexpr size_t kDepth = 64;
+    const size_t rounds = 1 << 14;
+    const size_t operations = 2 * rounds * kDepth;
+
+    std::cout << "Static list: push/pop churn of " << kDepth << " elements" << std::endl;
+    SingleLinkedList<std::uint64_t> dynamic;
+    const auto dynamic_time = MeasurePushPopChurn(report, dynamic, rounds, kDepth);
+    report.Add(MakeRecord("static", "SingleLinkedList", "PushPopChurn", "uint64", operations, dynamic_time));
+
+    struct ForwardList {
+        std::forward_list<std::uint64_t> list;
+        void PushFront(std::uint64_t value) {list.push_front(value);}
+        void PopFront() {list.pop_front();}
+        [[nodiscard]] bool IsEmpty() const {return list.empty();}
+        [[nodiscard]] auto begin() const {return list.begin();}
+    } forward;
+    const auto forward_time = MeasurePushPopChurn(report, forward, rounds, kDepth);
+    report.Add(MakeRecord("static", "std::forward_list", "PushPopChurn", "uint64", operations, forward_time));
+
+    StaticSingleLinkedList<std::uint64_t, kDepth> fixed;
+    const auto static_time = MeasurePushPopChurn(report, fixed, rounds, kDepth);
+    auto record = MakeRecord("static", "StaticSingleLinkedList", "PushPopChurn", "uint64", operations, static_time);
+    record.params = {{"object_bytes", static_cast<double>(sizeof(fixed))},
+                     {"speedup", dynamic_time.ms / static_time.ms}};
+    report.Add(std::move(record));
+}
+
+// Копирование и очистка copies списков с теми же значениями, что у source (уплотнённого, чтобы замер
+// копирования не сводился к промахам кэша при обходе источника). Копия тривиальных значений
+// занимает один слаб и заполняется через memcpy, а очистка такой копии не обходит узлы.
+// Очистка разбросанных по куче списков обходит их в обоих случаях, но без разрушения узлов по одному.
+// Списки для каждого замера готовятся вне его
+template <typename Point>
+std::array<Measurement, 3> MeasureCopyAndClear(BenchmarkReport& report, const SingleLinkedList<Point>& source,
+                                               size_t copies) {
+    std::array<Measurement, 3> best;
+    const auto measure = [&](Measurement& result, int repeat, auto&& f) {
+        report.StartCounters();
+        const auto start = Clock::now();
+        f();
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        auto counters = report.StopCounters();
+        if (repeat == 0 || elapsed.count() < result.ms) {
+            result.ms = elapsed.count();
+            result.counters = std::move(counters);
+        }
+    };
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        std::vector<SingleLinkedList<Point>> lists(copies);
+        measure(best[0], repeat, [&] {
+            for (auto& list : lists) {
+                list = source;
+            }
+        });
+        measure(best[1], repeat, [&] {
+            for (auto& list : lists) {
+                list.Clear();
+            }
+        });
+        for (size_t i = 0; i < copies; ++i) {
+            lists[i] = MakeScatteredList<Point>(source.GetSize(), static_cast<std::uint32_t>(i));
+        }
+        measure(best[2], repeat, [&] {
+            for (auto& list : lists) {
+                list.Clear();
+            }
+        });
+    }
+    return best;
+}
+
+void BenchmarkTrivialValues(BenchmarkReport& report, const BenchmarkOptions&) {
+    const size_t size = 1 << 16;
+    const size_t copies = 32;
+    const size_t elements = size * copies;
+
+    std::cout << "Trivial values: copy and clear of " << copies << " lists of " << size << " POD elements"
+              << std::endl;
+    SingleLinkedList<GenericPoint> generic_source = MakeScatteredList<GenericPoint>(size);
+    generic_source.Compact();
+    SingleLinkedList<TrivialPoint> trivial_source = MakeScatteredList<TrivialPoint>(size);
+    trivial_source.Compact();
+    const auto generic = MeasureCopyAndClear(report, generic_source, copies);
+    const auto trivial = MeasureCopyAndClear(report, trivial_source, copies);
+
+    const char* operations[] = {"Copy", "ClearCopy", "ClearScattered"};
+    for (size_t i = 0; i < std::size(operations); ++i) {
+        report.Add(MakeRecord("trivial", "generic path", operations[i], "pod16", elements, generic[i]));
+        auto record = MakeRecord("trivial", "trivial path", operations[i], "pod16", elements, trivial[i]);
+        record.params = {{"speedup", generic[i].ms / trivial[i].ms}};
+        report.Add(std::move(record));
+    }
+}
+
+// Обмены двух списков по size элементов, построенных через PushFront: встроенные узлы оказываются в хвосте,
+// и обмен со встроенными узлами обходит списки целиком
+template <typename Value>
+Measurement MeasureSwaps(BenchmarkReport& report, size_t size, size_t swaps) {
+    SingleLinkedList<Value> lhs;
+    SingleLinkedList<Value> rhs;
+    for (size_t i = 0; i < size; ++i) {
+        lhs.PushFront(static_cast<std::uint64_t>(i));
+        rhs.PushFront(static_cast<std::uint64_t>(size - i));
+    }
+    return report.Measure([&] {
+        for (size_t i = 0; i < swaps; ++i) {
+            lhs.swap(rhs);
+        }
+        DoNotOptimize(lhs.GetSize());
+    });
+}
+
+// Встроенные узлы: короткие списки не обращаются к куче, но обмен и перемещение стоят O(N) вместо O(1)
+void BenchmarkInlineNodes(BenchmarkReport& report, const BenchmarkOptions&) {
+    constexpr size_t kDepth = 4;
+    const size_t rounds = 1 << 18;
+    const size_t operations = 2 * rounds * kDepth;
+
+    std::cout << "Inline nodes: push/pop churn of " << kDepth << " elements and swaps of long lists" << std::endl;
+    SingleLinkedList<std::uint64_t> heap_list;
+    const auto heap_time = MeasurePushPopChurn(report, heap_list, rounds, kDepth);
+    report.Add(MakeRecord("inline", "heap nodes", "PushPopChurn", "uint64", operations, heap_time));
+    SingleLinkedList<InlineWord> inline_list;
+    const auto inline_time = MeasurePushPopChurn(report, inline_list, rounds, kDepth);
+    auto churn = MakeRecord("inline", "inline nodes", "PushPopChurn", "uint64", operations, inline_time);
+    churn.params = {{"speedup", heap_time.ms / inline_time.ms}};
+    report.Add(std::move(churn));
+
+    const size_t swaps = 1 << 10;
+    for (size_t size : {4u, 64u, 4096u}) {
+        const auto heap_swap = MeasureSwaps<std::uint64_t>(report, size, swaps);
+        auto heap_record = MakeRecord("inline", "heap nodes", "Swap", "uint64", swaps, heap_swap);
+        heap_record.params = {{"list_size", static_cast<double>(size)}};
+        report.Add(std::move(heap_record));
+        const auto inline_swap = MeasureSwaps<InlineWord>(report, size, swaps);
+        auto inline_record = MakeRecord("inline", "inline nodes", "Swap", "uint64", swaps, inline_swap);
+        inline_record.params = {{"list_size", static_cast<double>(size)},
+                                {"slowdown", inline_swap.ms / heap_swap.ms}};
+        report.Add(std::move(inline_record));
+    }
+}
+
+// Таблица для группы constexpr: цепочка из kBakedTableSize значений, построенная во время компиляции
+constexpr size_t kBakedTableSize = 4096;
+
+constexpr ConstexprSingleLinkedList<std::uint32_t, kBakedTableSize> MakeBakedTable() {
+    ConstexprSingleLinkedList<std::uint32_t, kBakedTableSize> table;
+    for (std::uint32_t i = kBakedTableSize; i > 0; --i) {
+        table.PushFront(i * 2654435761u);
+    }
+    return table;
+}
+
+constexpr auto kBakedTable = MakeBakedTable();
+
+// Запуск с таблицей: прежний путь строит SingleLinkedList из массива значений при каждом запуске,
+// готовая constexpr-таблица сразу читается из образа программы
+void BenchmarkConstexprTable(BenchmarkReport& report, const BenchmarkOptions&) {
+    std::vector<std::uint32_t> source(kBakedTable.begin(), kBakedTable.end());
+
+    std::cout << "Constexpr table: startup conversion and first pass over " << kBakedTableSize << " values"
+              << std::endl;
+    const auto runtime_time = report.Measure([&] {
+        SingleLinkedList<std::uint32_t> table;
+        for (auto it = source.rbegin(); it != source.rend(); ++it) {
+            table.PushFront(*it);
+        }
+        std::uint64_t sum = 0;
+        for (std::uint32_t value : table) {
+            sum += value;
+        }
+        DoNotOptimize(sum);
+    }, 20);
+    report.Add(MakeRecord("constexpr", "SingleLinkedList", "StartupPass", "uint32", kBakedTableSize, runtime_time));
+
+    const auto baked_time = report.Measure([&] {
+        std::uint64_t sum = 0;
+        for (std::uint32_t value : kBakedTable) {
+            sum += value;
+        }
+        DoNotOptimize(sum);
+    }, 20);
+    auto record = MakeRecord("constexpr", "ConstexprSingleLinkedList", "StartupPass", "uint32", kBakedTableSize,
+                             baked_time);
+    record.params = {{"speedup", runtime_time.ms / baked_time.ms}};
+    report.Add(std::move(record));
+}
+
+} // namespace
+
+// Разбирает аргументы командной строки:
+//   --max-size N    наибольший размер контейнера в группе operations (от 10 до 10^8)
+//   --max-bytes N   ограничение памяти на один набор данных
+//   --filter NAME   запускать только группы, в имени которых есть NAME
+//   --json PATH     сохранить результаты в JSON ("-" - в стандартный вывод)
+//   --no-perf       не снимать аппаратные счётчики производительности
+BenchmarkOptions ParseBenchmarkOptions(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--no-perf") {
+            options.perf_counters = false;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        const std::string value = argv[++i];
+        if (arg == "--max-size") {
+            options.max_size = std::stoull(value);
+        } else if (arg == "--max-bytes") {
+            options.max_bytes = std::stoull(value);
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--json") {
+            options.json_path = value;
+        } else {
+            throw std::invalid_argument("Unknown option " + arg);
+        }
+    }
+    return options;
+}
+
+void RunBenchmarks(const BenchmarkOptions& options) {
+    using BenchmarkGroup = void (*)(BenchmarkReport&, const BenchmarkOptions&);
+    const std::pair<const char*, BenchmarkGroup> groups[] = {
+        {"operations", BenchmarkOperations},
+        {"parallel", BenchmarkParallelScaling},
+        {"prefetch", BenchmarkPrefetchedTraversal},
+        {"batch_find", BenchmarkBatchFind},
+        {"compaction", BenchmarkCompaction},
+        {"equality", BenchmarkEquality},
+        {"hashing", BenchmarkHashing},
+        {"serialization", BenchmarkSerialization},
+        {"mapped", BenchmarkMappedStartup},
+        {"snapshots", BenchmarkSnapshots},
+        {"cow", BenchmarkCopyOnWrite},
+        {"positional", BenchmarkPositional},
+        {"sorted", BenchmarkSorted},
+        {"hash_index", BenchmarkHashIndex},
+        {"lru", BenchmarkLru},
+        {"linked_hash", BenchmarkLinkedHashMap},
+        {"static", BenchmarkStaticList},
+        {"inline", BenchmarkInlineNodes},
+        {"constexpr", BenchmarkConstexprTable},
+        {"trivial", BenchmarkTrivialValues},
+        {"memory", BenchmarkMemoryFootprint},
+    };
+
+    BenchmarkReport report(options.perf_counters);
+    for (const auto& [name, run] : groups) {
+        if (std::string(name).find(options.filter) != std::string::npos) {
+            run(report, options);
+        }
+    }
+
+    if (options.json_path == "-") {
+        report.WriteJson(std::cout);
+    } else if (!options.json_path.empty()) {
+        std::ofstream out(options.json_path);
+        if (!out) {
+            throw std::runtime_error("Cannot open " + options.json_path);
+        }
+        report.WriteJson(out);
+    }
+}
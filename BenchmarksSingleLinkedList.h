@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "SingleLinkedList.h"
+
+// Параметры запуска бенчмарков
+struct BenchmarkOptions {
+    size_t max_size = 1000000;              // Наибольший размер контейнера в группе operations
+    size_t max_bytes = size_t{2} << 30;     // Ограничение памяти на один набор данных
+    std::string filter;                     // Запускать только группы, в имени которых есть эта подстрока
+    std::string json_path;                  // Куда сохранить результаты в JSON ("-" - стандартный вывод)
+    bool perf_counters = true;              // Снимать ли аппаратные счётчики (если доступны)
+};
+
+BenchmarkOptions ParseBenchmarkOptions(int argc, char* argv[]);
+void RunBenchmarks(const BenchmarkOptions& options);
@@ -0,0 +1,33 @@
+TEMPLATE = app
+TARGET = BenchmarksSingleLinkedList
+CONFIG += console c++17 thread release
+CONFIG -= app_bundle
+CONFIG -= qt
+
+SOURCES += \
+        BenchmarksSingleLinkedList.cpp \
+        benchmarks_main.cpp
+
+HEADERS += \
+    BenchmarksSingleLinkedList.h \
+    ConstexprSingleLinkedList.h \
+    CowSingleLinkedList.h \
+    HashIndexedSingleLinkedList.h \
+    LinkedHashMap.h \
+    LruCache.h \
+    MappedSingleLinkedList.h \
+    NodePool.h \
+    ParallelSingleLinkedList.h \
+    PerfCounters.h \
+    PersistentSingleLinkedList.h \
+    PrefetchSingleLinkedList.h \
+    SingleLinkedList.h \
+    SingleLinkedListHash.h \
+    SingleLinkedListIndex.h \
+    SingleLinkedListInline.h \
+    SingleLinkedListMemory.h \
+    SingleLinkedListSerialization.h \
+    SingleLinkedListStats.h \
+    SortedSingleLinkedList.h \
+    StaticSingleLinkedList.h \
+    StreamingSingleLinkedList.h
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "StaticSingleLinkedList.h"
+
+// Односвязный список не больше чем на Capacity элементов, все операции которого - constexpr.
+// Список можно построить во время компиляции и сохранить в constexpr-переменной: он попадёт в образ программы
+// готовым, и при запуске не нужно ни выделять узлы, ни копировать в них элементы.
+// Устроен как StaticSingleLinkedList (ячейки встроенного массива, ссылки - номера ячеек, список свободных),
+// но C++17 не позволяет размещать объекты в сырой памяти во время компиляции, поэтому все Capacity элементов
+// существуют всегда: незанятые ячейки хранят Type{}, а вставка присваивает значение ячейке.
+// Отсюда требования к Type: конструктор по умолчанию, присваивание и тривиальный деструктор.
+// Переполнение - исключение std::length_error, а при вычислении во время компиляции - ошибка компиляции
+template <typename Type, size_t Capacity>
+class ConstexprSingleLinkedList {
+    static_assert(Capacity > 0, "ConstexprSingleLinkedList needs room for at least one element");
+    static_assert(std::is_default_constructible_v<Type> && std::is_trivially_destructible_v<Type>,
+                  "ConstexprSingleLinkedList elements must be default-constructible literal types");
+
+    // Номер ячейки. Номер Capacity - фиктивный узел перед первым элементом, Capacity + 1 - конец списка
+    using Index = static_list_detail::IndexFor<Capacity + 1>;
+    static constexpr Index kHead = static_cast<Index>(Capacity);
+    static constexpr Index kNil = static_cast<Index>(Capacity + 1);
+
+    template <typename ValueType>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    using value_type = Type;
+    using reference = Type&;
+    using const_reference = const Type&;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    constexpr ConstexprSingleLinkedList() noexcept {next_[kHead] = kNil;}
+    constexpr ConstexprSingleLinkedList(std::initializer_list<Type> values);
+
+    [[nodiscard]] constexpr size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] constexpr bool IsEmpty() const noexcept {return size_ == 0;}
+    [[nodiscard]] constexpr bool IsFull() const noexcept {return size_ == Capacity;}
+    [[nodiscard]] static constexpr size_t GetCapacity() noexcept {return Capacity;}
+
+    constexpr void PushFront(const Type& value);    // Вставка в начало; в заполненном списке - std::length_error
+    constexpr void PopFront() noexcept;             // Удаляет первый элемент непустого списка
+    constexpr void Clear() noexcept;                // Очищает список за O(N)
+
+    // Вставка после pos; в заполненном списке - std::length_error
+    constexpr Iterator InsertAfter(ConstIterator pos, const Type& value);
+    // Удаление элемента после pos. Возвращает итератор на следующий элемент
+    constexpr Iterator EraseAfter(ConstIterator pos) noexcept;
+
+    // Первый элемент, равный value (end(), если такого нет)
+    [[nodiscard]] constexpr ConstIterator Find(const Type& value) const;
+
+    [[nodiscard]] constexpr Iterator begin() noexcept {return Iterator(this, next_[kHead]);}
+    [[nodiscard]] constexpr Iterator end() noexcept {return Iterator(this, kNil);}
+    [[nodiscard]] constexpr ConstIterator begin() const noexcept {return ConstIterator(this, next_[kHead]);}
+    [[nodiscard]] constexpr ConstIterator end() const noexcept {return ConstIterator(this, kNil);}
+    [[nodiscard]] constexpr ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] constexpr ConstIterator cend() const noexcept {return end();}
+    [[nodiscard]] constexpr Iterator before_begin() noexcept {return Iterator(this, kHead);}
+    [[nodiscard]] constexpr ConstIterator before_begin() const noexcept {return ConstIterator(this, kHead);}
+    [[nodiscard]] constexpr ConstIterator cbefore_begin() const noexcept {return before_begin();}
+
+private:
+    Type values_[Capacity] = {};
+    Index next_[Capacity + 1] = {};     // next_[kHead] - первый элемент; у свободных ячеек - следующая свободная
+    Index free_ = kNil;                 // Первая освобождённая ячейка
+    Index used_ = 0;                    // Ячейки [0, used_) хотя бы раз выдавались
+    size_t size_ = 0;
+};
+
+// Итератор хранит список и номер ячейки, как итератор StaticSingleLinkedList
+template <typename Type, size_t Capacity>
+template <typename ValueType>
+class ConstexprSingleLinkedList<Type, Capacity>::BasicIterator {
+    friend class ConstexprSingleLinkedList<Type, Capacity>;
+
+    using List = std::conditional_t<std::is_const_v<ValueType>, const ConstexprSingleLinkedList,
+                                    ConstexprSingleLinkedList>;
+
+    constexpr BasicIterator(List* list, Index index) noexcept
+        : list_(list)
+        , index_(index) {
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    constexpr BasicIterator() = default;
+    // Неконстантный итератор преобразуется в константный
+    constexpr BasicIterator(const BasicIterator<Type>& other) noexcept
+        : list_(other.list_)
+        , index_(other.index_) {
+    }
+    constexpr BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+    [[nodiscard]] constexpr bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+        return index_ == rhs.index_ && list_ == rhs.list_;
+    }
+    [[nodiscard]] constexpr bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+    constexpr BasicIterator& operator++() noexcept {
+        assert(index_ != kNil);
+        index_ = list_->next_[index_];
+        return *this;
+    }
+
+    constexpr BasicIterator operator++(int) noexcept {
+        auto old_value(*this);
+        ++(*this);
+        return old_value;
+    }
+
+    [[nodiscard]] constexpr reference operator*() const noexcept {
+        assert(index_ < Capacity);
+        return list_->values_[index_];
+    }
+    [[nodiscard]] constexpr pointer operator->() const noexcept {return &**this;}
+
+private:
+    template <typename>
+    friend class BasicIterator;
+
+    List* list_ = nullptr;
+    Index index_ = kNil;
+};
+
+// Элементы сверх Capacity - исключение std::length_error
+template <typename Type, size_t Capacity>
+constexpr ConstexprSingleLinkedList<Type, Capacity>::ConstexprSingleLinkedList(std::initializer_list<Type> values)
+    : ConstexprSingleLinkedList() {
+    ConstIterator tail = cbefore_begin();
+    for (const Type& value : values) {
+        tail = InsertAfter(tail, value);
+    }
+}
+
+template <typename Type, size_t Capacity>
+constexpr void ConstexprSingleLinkedList<Type, Capacity>::PushFront(const Type& value) {
+    InsertAfter(cbefore_begin(), value);
+}
+
+template <typename Type, size_t Capacity>
+constexpr void ConstexprSingleLinkedList<Type, Capacity>::PopFront() noexcept {
+    assert(!IsEmpty());
+    EraseAfter(cbefore_begin());
+}
+
+// Ячейкам возвращаются значения Type{}, чтобы одинаковые списки были одинаковыми и побайтно
+template <typename Type, size_t Capacity>
+constexpr void ConstexprSingleLinkedList<Type, Capacity>::Clear() noexcept {
+    for (size_t i = 0; i < used_; ++i) {
+        values_[i] = Type{};
+    }
+    next_[kHead] = kNil;
+    free_ = kNil;
+    used_ = 0;
+    size_ = 0;
+}
+
+// Ячейка берётся сначала из освобождённых. Если присваивание value выбросит исключение, список не меняется
+template <typename Type, size_t Capacity>
+constexpr typename ConstexprSingleLinkedList<Type, Capacity>::Iterator ConstexprSingleLinkedList<Type, Capacity>::
+        InsertAfter(ConstIterator pos, const Type& value) {
+    assert(pos.list_ == this && pos.index_ != kNil);
+    if (IsFull()) {
+        throw std::length_error("ConstexprSingleLinkedList capacity exceeded");
+    }
+    const Index index = free_ != kNil ? free_ : used_;
+    values_[index] = value;
+    if (index == free_) {
+        free_ = next_[index];
+    } else {
+        ++used_;
+    }
+    next_[index] = next_[pos.index_];
+    next_[pos.index_] = index;
+    ++size_;
+    return Iterator(this, index);
+}
+
+template <typename Type, size_t Capacity>
+constexpr typename ConstexprSingleLinkedList<Type, Capacity>::Iterator ConstexprSingleLinkedList<Type, Capacity>::
+        EraseAfter(ConstIterator pos) noexcept {
+    assert(pos.list_ == this && pos.index_ != kNil && next_[pos.index_] != kNil);
+    const Index erased = next_[pos.index_];
+    next_[pos.index_] = next_[erased];
+    values_[erased] = Type{};
+    next_[erased] = free_;
+    free_ = erased;
+    --size_;
+    return Iterator(this, next_[pos.index_]);
+}
+
+template <typename Type, size_t Capacity>
+[[nodiscard]] constexpr typename ConstexprSingleLinkedList<Type, Capacity>::ConstIterator
+        ConstexprSingleLinkedList<Type, Capacity>::Find(const Type& value) const {
+    ConstIterator it = begin();
+    while (it != end() && !(*it == value)) {
+        ++it;
+    }
+    return it;
+}
+
+// Сравнения написаны циклами: std::equal и std::lexicographical_compare становятся constexpr только в C++20
+template <typename Type, size_t Capacity>
+constexpr bool operator==(const ConstexprSingleLinkedList<Type, Capacity>& lhs,
+                          const ConstexprSingleLinkedList<Type, Capacity>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    for (auto left = lhs.begin(), right = rhs.begin(); left != lhs.end(); ++left, ++right) {
+        if (!(*left == *right)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator!=(const ConstexprSingleLinkedList<Type, Capacity>& lhs,
+                          const ConstexprSingleLinkedList<Type, Capacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator<(const ConstexprSingleLinkedList<Type, Capacity>& lhs,
+                         const ConstexprSingleLinkedList<Type, Capacity>& rhs) {
+    auto left = lhs.begin();
+    auto right = rhs.begin();
+    for (; left != lhs.end() && right != rhs.end(); ++left, ++right) {
+        if (*left < *right) {
+            return true;
+        }
+        if (*right < *left) {
+            return false;
+        }
+    }
+    return left == lhs.end() && right != rhs.end();
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator<=(const ConstexprSingleLinkedList<Type, Capacity>& lhs,
+                          const ConstexprSingleLinkedList<Type, Capacity>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator>(const ConstexprSingleLinkedList<Type, Capacity>& lhs,
+                         const ConstexprSingleLinkedList<Type, Capacity>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t Capacity>
+constexpr bool operator>=(const ConstexprSingleLinkedList<Type, Capacity>& lhs,
+                          const ConstexprSingleLinkedList<Type, Capacity>& rhs) {
+    return !(lhs < rhs);
+}
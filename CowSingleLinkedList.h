@@ -0,0 +1,266 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "PersistentSingleLinkedList.h"
+
+// Односвязный список с копированием при записи. Копии делят цепочку узлов (узлы PersistentSingleLinkedList
+// со счётчиком ссылок), поэтому копирование и присваивание работают за O(1).
+// Изменение копирует только то, что нужно, чтобы не задеть другие списки:
+// PushFront и PopFront - ничего, InsertAfter и EraseAfter - общие узлы от начала списка до места изменения.
+// Как и SingleLinkedList, требует конструктора Type по умолчанию (для фиктивного узла).
+// Элементы доступны только для чтения; итераторы на общую часть списка после изменения
+// недействительны для этого списка, так как она могла быть скопирована
+template <typename Type>
+class CowSingleLinkedList {
+    using Node = persistent_detail::Node<Type>;
+
+public:
+    using ConstIterator = persistent_detail::ConstIterator<Type>;
+
+    using value_type = Type;
+    using reference = const Type&;
+    using const_reference = const Type&;
+    using iterator = ConstIterator;
+    using const_iterator = ConstIterator;
+
+    CowSingleLinkedList() = default;
+    CowSingleLinkedList(std::initializer_list<Type> values);
+    template <typename InputIt>
+    CowSingleLinkedList(InputIt first, InputIt last);               // Копирует элементы диапазона
+    CowSingleLinkedList(const CowSingleLinkedList& other) noexcept;    // Делит узлы с other за O(1)
+    CowSingleLinkedList(CowSingleLinkedList&& other) noexcept;
+    ~CowSingleLinkedList();
+
+    CowSingleLinkedList& operator=(const CowSingleLinkedList& rhs) noexcept;
+    CowSingleLinkedList& operator=(CowSingleLinkedList&& rhs) noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] bool IsEmpty() const noexcept {return size_ == 0;}
+
+    void PushFront(const Type& value);              // O(1), общие узлы не копируются
+    void PopFront() noexcept;                       // O(1), общий первый узел только теряет ссылку
+    void Clear() noexcept;
+    void swap(CowSingleLinkedList& other) noexcept;
+
+    // Вставка после pos. Если узлы до pos общие с другими списками, они копируются
+    ConstIterator InsertAfter(ConstIterator pos, const Type& value);
+    // Удаление элемента после pos с тем же копированием общих узлов до pos.
+    // Возвращает итератор на элемент, следующий за удалённым
+    ConstIterator EraseAfter(ConstIterator pos);
+
+    [[nodiscard]] ConstIterator begin() const noexcept {return ConstIterator(head_.next);}
+    [[nodiscard]] ConstIterator end() const noexcept {return ConstIterator(nullptr);}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+    [[nodiscard]] ConstIterator before_begin() const noexcept {return ConstIterator(&head_);}
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {return before_begin();}
+
+private:
+    // Фиктивный узел; принадлежит только этому списку и держит ссылку на первый узел
+    Node head_{nullptr};
+    size_t size_ = 0;
+    // Все узлы списка принадлежат только ему: изменения не требуют проверки счётчиков.
+    // Сбрасывается, когда список копируют, в том числе из другого потока через const-ссылку
+    mutable std::atomic<bool> exclusive_{true};
+
+    [[nodiscard]] Node* MakeMutable(const Node* pos);
+    [[nodiscard]] static Node* AsMutable(const Node* node) noexcept {return const_cast<Node*>(node);}
+};
+
+template <typename Type>
+CowSingleLinkedList<Type>::CowSingleLinkedList(std::initializer_list<Type> values)
+    : CowSingleLinkedList(values.begin(), values.end()) {
+}
+
+// Элементы добавляются во временный список, чтобы при исключении его узлы освободил деструктор
+template <typename Type>
+template <typename InputIt>
+CowSingleLinkedList<Type>::CowSingleLinkedList(InputIt first, InputIt last) {
+    CowSingleLinkedList tmp;
+    for (ConstIterator pos = tmp.before_begin(); first != last; ++first) {
+        pos = tmp.InsertAfter(pos, *first);
+    }
+    swap(tmp);
+}
+
+template <typename Type>
+CowSingleLinkedList<Type>::CowSingleLinkedList(const CowSingleLinkedList& other) noexcept
+    : size_(other.size_)
+    , exclusive_(other.size_ == 0) {
+    head_.next = persistent_detail::Acquire(other.head_.next);
+    if (size_ != 0) {
+        other.exclusive_.store(false, std::memory_order_relaxed);
+    }
+}
+
+template <typename Type>
+CowSingleLinkedList<Type>::CowSingleLinkedList(CowSingleLinkedList&& other) noexcept {
+    swap(other);
+}
+
+template <typename Type>
+CowSingleLinkedList<Type>::~CowSingleLinkedList() {
+    persistent_detail::Release(head_.next);
+}
+
+template <typename Type>
+CowSingleLinkedList<Type>& CowSingleLinkedList<Type>::operator=(const CowSingleLinkedList& rhs) noexcept {
+    CowSingleLinkedList tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename Type>
+CowSingleLinkedList<Type>& CowSingleLinkedList<Type>::operator=(CowSingleLinkedList&& rhs) noexcept {
+    if (this != &rhs) {
+        CowSingleLinkedList tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+// Новый узел забирает ссылку фиктивного узла на прежний первый узел
+template <typename Type>
+void CowSingleLinkedList<Type>::PushFront(const Type& value) {
+    head_.next = new Node(head_.next, value);
+    ++size_;
+}
+
+// Свой первый узел удаляется, общий - только теряет ссылку этого списка
+template <typename Type>
+void CowSingleLinkedList<Type>::PopFront() noexcept {
+    assert(head_.next != nullptr);
+    const Node* first = head_.next;
+    if (first->refs.load(std::memory_order_acquire) == 1) {
+        head_.next = first->next;
+        delete first;
+    } else {
+        head_.next = persistent_detail::Acquire(first->next);
+        persistent_detail::Release(first);
+    }
+    --size_;
+}
+
+template <typename Type>
+void CowSingleLinkedList<Type>::Clear() noexcept {
+    persistent_detail::Release(head_.next);
+    head_.next = nullptr;
+    size_ = 0;
+    exclusive_.store(true, std::memory_order_relaxed);
+}
+
+template <typename Type>
+void CowSingleLinkedList<Type>::swap(CowSingleLinkedList& other) noexcept {
+    std::swap(head_.next, other.head_.next);
+    std::swap(size_, other.size_);
+    const bool exclusive = exclusive_.load(std::memory_order_relaxed);
+    exclusive_.store(other.exclusive_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.exclusive_.store(exclusive, std::memory_order_relaxed);
+}
+
+template <typename Type>
+typename CowSingleLinkedList<Type>::ConstIterator CowSingleLinkedList<Type>::InsertAfter(ConstIterator pos,
+                                                                                       const Type& value) {
+    Node* node = MakeMutable(pos.GetNode());
+    node->next = new Node(node->next, value);
+    ++size_;
+    return ConstIterator(node->next);
+}
+
+// Удаляемый узел, на который больше никто не ссылается, разрушается; общий - остаётся другим спискам
+template <typename Type>
+typename CowSingleLinkedList<Type>::ConstIterator CowSingleLinkedList<Type>::EraseAfter(ConstIterator pos) {
+    Node* node = MakeMutable(pos.GetNode());
+    const Node* erased = node->next;
+    assert(erased != nullptr);
+    if (erased->refs.load(std::memory_order_acquire) == 1) {
+        node->next = erased->next;
+        delete erased;
+    } else {
+        node->next = persistent_detail::Acquire(erased->next);
+        persistent_detail::Release(erased);
+    }
+    --size_;
+    return ConstIterator(node->next);
+}
+
+// Возвращает узел, который можно менять, на месте pos. Узел принадлежит только этому списку,
+// если у него и у всех узлов перед ним по одной ссылке. Начиная с первого общего узла и до pos
+// узлы копируются; копия присоединяется к остальной (по-прежнему общей) части списка
+template <typename Type>
+[[nodiscard]] typename CowSingleLinkedList<Type>::Node* CowSingleLinkedList<Type>::MakeMutable(const Node* pos) {
+    if (pos == &head_ || exclusive_.load(std::memory_order_relaxed)) {
+        return AsMutable(pos);
+    }
+    Node* prev = &head_;
+    while (prev != pos) {
+        const Node* shared = prev->next;
+        assert(shared != nullptr && "pos must point into this list");
+        if (shared->refs.load(std::memory_order_acquire) == 1) {
+            prev = AsMutable(shared);
+            continue;
+        }
+
+        // Копия отрезка [shared, pos]. При исключении уже скопированные узлы освобождаются
+        Node* first_copy = nullptr;
+        Node* last_copy = nullptr;
+        try {
+            for (const Node* source = shared;; source = source->next) {
+                Node* copy = new Node(nullptr, source->value);
+                if (first_copy == nullptr) {
+                    first_copy = copy;
+                } else {
+                    last_copy->next = copy;
+                }
+                last_copy = copy;
+                if (source == pos) {
+                    break;
+                }
+            }
+        } catch (...) {
+            persistent_detail::Release<Type>(first_copy);
+            throw;
+        }
+        last_copy->next = persistent_detail::Acquire(pos->next);
+        prev->next = first_copy;
+        persistent_detail::Release(shared);
+        return last_copy;
+    }
+    // Дошли до конца списка, не встретив общих узлов: список снова принадлежит только себе
+    if (pos->next == nullptr) {
+        exclusive_.store(true, std::memory_order_relaxed);
+    }
+    return prev;
+}
+
+template <typename Type>
+void swap(CowSingleLinkedList<Type>& lhs, CowSingleLinkedList<Type>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// Списки, которые с какого-то места делят узлы, дальше не сравниваются
+template <typename Type>
+bool operator==(const CowSingleLinkedList<Type>& lhs, const CowSingleLinkedList<Type>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    for (auto l = lhs.begin(), r = rhs.begin(); l != lhs.end(); ++l, ++r) {
+        if (l.GetNode() == r.GetNode()) {
+            return true;
+        }
+        if (!(*l == *r)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type>
+bool operator!=(const CowSingleLinkedList<Type>& lhs, const CowSingleLinkedList<Type>& rhs) {
+    return !(lhs == rhs);
+}
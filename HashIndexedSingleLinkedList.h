@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "SingleLinkedList.h"
+
+// Односвязный список с хэш-индексом значений. Элементы хранятся в обычном SingleLinkedList в порядке вставки,
+// а индекс - таблица с открытой адресацией (линейное пробирование) - хранит для каждого элемента его предшественника.
+// Find, Contains и EraseValue работают за ожидаемое O(1); PushFront, InsertAfter и EraseAfter обновляют
+// индекс за O(1): кроме самого элемента меняется только предшественник следующего за ним.
+// Элементы доступны только для чтения, иначе индекс разошёлся бы со значениями
+template <typename Type, typename Hash = std::hash<Type>, typename Equal = std::equal_to<Type>>
+class HashIndexedSingleLinkedList {
+public:
+    using ConstIterator = typename SingleLinkedList<Type>::ConstIterator;
+
+    using value_type = Type;
+    using reference = const Type&;
+    using const_reference = const Type&;
+    using iterator = ConstIterator;
+    using const_iterator = ConstIterator;
+
+    HashIndexedSingleLinkedList() = default;
+    HashIndexedSingleLinkedList(std::initializer_list<Type> values);
+    HashIndexedSingleLinkedList(const HashIndexedSingleLinkedList& other);
+    HashIndexedSingleLinkedList(HashIndexedSingleLinkedList&& other) noexcept;
+
+    HashIndexedSingleLinkedList& operator=(const HashIndexedSingleLinkedList& rhs);
+    HashIndexedSingleLinkedList& operator=(HashIndexedSingleLinkedList&& rhs) noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return list_.GetSize();}
+    [[nodiscard]] bool IsEmpty() const noexcept {return list_.IsEmpty();}
+
+    void PushFront(const Type& value);
+    void PopFront();
+    // Вставка после pos. Если хэширование или выделение памяти выбросит исключение, список не меняется
+    ConstIterator InsertAfter(ConstIterator pos, const Type& value);
+    // Удаление элемента после pos. Возвращает итератор на следующий элемент
+    ConstIterator EraseAfter(ConstIterator pos);
+    void Clear() noexcept;
+    void swap(HashIndexedSingleLinkedList& other) noexcept;
+
+    // Элемент, равный value (end(), если такого нет). Из нескольких равных возвращается какой-то один
+    [[nodiscard]] ConstIterator Find(const Type& value) const;
+    [[nodiscard]] bool Contains(const Type& value) const {return Find(value) != end();}
+    // Удаляет все элементы, равные value. Возвращает количество удалённых
+    size_t EraseValue(const Type& value);
+
+    // Сам список: узлы лежат так же, как в любом SingleLinkedList
+    [[nodiscard]] const SingleLinkedList<Type>& GetList() const noexcept {return list_;}
+
+    [[nodiscard]] ConstIterator begin() const noexcept {return list_.cbegin();}
+    [[nodiscard]] ConstIterator end() const noexcept {return list_.cend();}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+    [[nodiscard]] ConstIterator before_begin() const noexcept {return list_.cbefore_begin();}
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {return before_begin();}
+
+private:
+    // Ячейка таблицы: перемешанный хэш значения со старшим битом-признаком занятости и предшественник элемента.
+    // Предшественник первого элемента хранится как ConstIterator{}, а не before_begin(): адрес фиктивного узла
+    // меняется при перемещении списка, а таблица при этом должна оставаться действительной
+    struct Slot {
+        std::uint64_t tag = 0;
+        ConstIterator prev;
+    };
+
+    static constexpr std::uint64_t kOccupied = std::uint64_t{1} << 63;
+    static constexpr size_t kMinCapacity = 8;
+
+    SingleLinkedList<Type> list_;
+    std::vector<Slot> slots_;       // Размер - степень двойки; занято не больше 3/4 ячеек
+    Hash hash_;
+    Equal equal_;
+
+    [[nodiscard]] std::uint64_t GetTag(const Type& value) const;
+    [[nodiscard]] ConstIterator StoredPrev(ConstIterator prev) const noexcept;
+    [[nodiscard]] ConstIterator ElementOf(const Slot& slot) const noexcept;
+    [[nodiscard]] size_t FindSlot(std::uint64_t tag, ConstIterator stored_prev) const noexcept;
+    [[nodiscard]] size_t FindValueSlot(const Type& value) const;
+    void Reserve(size_t count);
+    void PlaceSlot(const Slot& slot) noexcept;
+    void RemoveSlot(size_t index) noexcept;
+    void RebuildIndex();
+    void RelocateSlots(const SingleLinkedList<Type>& from) noexcept;
+};
+
+template <typename Type, typename Hash, typename Equal>
+HashIndexedSingleLinkedList<Type, Hash, Equal>::HashIndexedSingleLinkedList(std::initializer_list<Type> values)
+    : list_(values) {
+    RebuildIndex();
+}
+
+template <typename Type, typename Hash, typename Equal>
+HashIndexedSingleLinkedList<Type, Hash, Equal>::HashIndexedSingleLinkedList(const HashIndexedSingleLinkedList& other)
+    : list_(other.list_)
+    , hash_(other.hash_)
+    , equal_(other.equal_) {
+    RebuildIndex();
+}
+
+// Узлы при перемещении остаются на месте, поэтому таблица переходит вместе со списком.
+// Пересчитать нужно только предшественников из встроенных ячеек
+template <typename Type, typename Hash, typename Equal>
+HashIndexedSingleLinkedList<Type, Hash, Equal>::HashIndexedSingleLinkedList(
+        HashIndexedSingleLinkedList&& other) noexcept
+    : list_(std::move(other.list_))
+    , slots_(std::move(other.slots_))
+    , hash_(other.hash_)
+    , equal_(other.equal_) {
+    other.slots_.clear();
+    RelocateSlots(other.list_);
+}
+
+template <typename Type, typename Hash, typename Equal>
+HashIndexedSingleLinkedList<Type, Hash, Equal>& HashIndexedSingleLinkedList<Type, Hash, Equal>::operator=(
+        const HashIndexedSingleLinkedList& rhs) {
+    if (this != &rhs) {
+        HashIndexedSingleLinkedList tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename Type, typename Hash, typename Equal>
+HashIndexedSingleLinkedList<Type, Hash, Equal>& HashIndexedSingleLinkedList<Type, Hash, Equal>::operator=(
+        HashIndexedSingleLinkedList&& rhs) noexcept {
+    if (this != &rhs) {
+        HashIndexedSingleLinkedList tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::PushFront(const Type& value) {
+    InsertAfter(before_begin(), value);
+}
+
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::PopFront() {
+    assert(!IsEmpty());
+    EraseAfter(before_begin());
+}
+
+// Всё, что может выбросить исключение (хэширование, рост таблицы, создание узла), делается до изменения индекса.
+// Следующий за pos элемент получает предшественником новый узел
+template <typename Type, typename Hash, typename Equal>
+typename HashIndexedSingleLinkedList<Type, Hash, Equal>::ConstIterator
+HashIndexedSingleLinkedList<Type, Hash, Equal>::InsertAfter(ConstIterator pos, const Type& value) {
+    const std::uint64_t tag = GetTag(value);
+    const ConstIterator next = std::next(pos);
+    const std::uint64_t next_tag = next != end() ? GetTag(*next) : 0;
+    Reserve(GetSize() + 1);
+    const ConstIterator inserted = list_.InsertAfter(pos, value);
+    if (next != end()) {
+        slots_[FindSlot(next_tag, StoredPrev(pos))].prev = inserted;
+    }
+    PlaceSlot(Slot{tag, StoredPrev(pos)});
+    return inserted;
+}
+
+// Элемент после удалённого получает предшественником pos
+template <typename Type, typename Hash, typename Equal>
+typename HashIndexedSingleLinkedList<Type, Hash, Equal>::ConstIterator
+HashIndexedSingleLinkedList<Type, Hash, Equal>::EraseAfter(ConstIterator pos) {
+    const ConstIterator erased = std::next(pos);
+    assert(erased != end());
+    const ConstIterator next = std::next(erased);
+    const std::uint64_t tag = GetTag(*erased);
+    const std::uint64_t next_tag = next != end() ? GetTag(*next) : 0;
+    RemoveSlot(FindSlot(tag, StoredPrev(pos)));
+    if (next != end()) {
+        slots_[FindSlot(next_tag, erased)].prev = StoredPrev(pos);
+    }
+    return list_.EraseAfter(pos);
+}
+
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::Clear() noexcept {
+    list_.Clear();
+    std::vector<Slot>().swap(slots_);
+}
+
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::swap(HashIndexedSingleLinkedList& other) noexcept {
+    list_.swap(other.list_);
+    slots_.swap(other.slots_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+    RelocateSlots(other.list_);
+    other.RelocateSlots(list_);
+}
+
+template <typename Type, typename Hash, typename Equal>
+[[nodiscard]] typename HashIndexedSingleLinkedList<Type, Hash, Equal>::ConstIterator
+HashIndexedSingleLinkedList<Type, Hash, Equal>::Find(const Type& value) const {
+    const size_t index = FindValueSlot(value);
+    return index < slots_.size() ? ElementOf(slots_[index]) : end();
+}
+
+// Каждое удаление меняет предшественников соседей, поэтому следующий равный элемент ищется заново
+template <typename Type, typename Hash, typename Equal>
+size_t HashIndexedSingleLinkedList<Type, Hash, Equal>::EraseValue(const Type& value) {
+    size_t erased = 0;
+    for (size_t index = FindValueSlot(value); index < slots_.size(); index = FindValueSlot(value)) {
+        const ConstIterator prev = slots_[index].prev;
+        EraseAfter(prev == ConstIterator{} ? before_begin() : prev);
+        ++erased;
+    }
+    return erased;
+}
+
+// Хэш перемешивается: слабые хэши вроде тождественного std::hash<int> иначе давали бы длинные цепочки проб
+template <typename Type, typename Hash, typename Equal>
+[[nodiscard]] std::uint64_t HashIndexedSingleLinkedList<Type, Hash, Equal>::GetTag(const Type& value) const {
+    return list_hash_detail::Mix(static_cast<std::uint64_t>(hash_(value))) | kOccupied;
+}
+
+// Предшественник в том виде, в каком он хранится в таблице
+template <typename Type, typename Hash, typename Equal>
+[[nodiscard]] typename HashIndexedSingleLinkedList<Type, Hash, Equal>::ConstIterator
+HashIndexedSingleLinkedList<Type, Hash, Equal>::StoredPrev(ConstIterator prev) const noexcept {
+    return prev == before_begin() ? ConstIterator{} : prev;
+}
+
+template <typename Type, typename Hash, typename Equal>
+[[nodiscard]] typename HashIndexedSingleLinkedList<Type, Hash, Equal>::ConstIterator
+HashIndexedSingleLinkedList<Type, Hash, Equal>::ElementOf(const Slot& slot) const noexcept {
+    return slot.prev == ConstIterator{} ? begin() : std::next(slot.prev);
+}
+
+// Ячейка элемента с данным предшественником. Элемент обязан быть в таблице
+template <typename Type, typename Hash, typename Equal>
+[[nodiscard]] size_t HashIndexedSingleLinkedList<Type, Hash, Equal>::FindSlot(std::uint64_t tag,
+                                                                             ConstIterator stored_prev) const noexcept {
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = tag & mask;; index = (index + 1) & mask) {
+        assert(slots_[index].tag != 0);
+        if (slots_[index].tag == tag && slots_[index].prev == stored_prev) {
+            return index;
+        }
+    }
+}
+
+// Ячейка какого-нибудь элемента, равного value (slots_.size(), если такого нет)
+template <typename Type, typename Hash, typename Equal>
+[[nodiscard]] size_t HashIndexedSingleLinkedList<Type, Hash, Equal>::FindValueSlot(const Type& value) const {
+    if (slots_.empty()) {
+        return 0;
+    }
+    const std::uint64_t tag = GetTag(value);
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = tag & mask; slots_[index].tag != 0; index = (index + 1) & mask) {
+        if (slots_[index].tag == tag && equal_(*ElementOf(slots_[index]), value)) {
+            return index;
+        }
+    }
+    return slots_.size();
+}
+
+// Растит таблицу так, чтобы count элементов занимали не больше 3/4 ячеек.
+// Ячейки переносятся по сохранённым хэшам, без повторного хэширования значений
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::Reserve(size_t count) {
+    if (count * 4 <= slots_.size() * 3) {
+        return;
+    }
+    size_t capacity = std::max(kMinCapacity, slots_.size());
+    while (count * 4 > capacity * 3) {
+        capacity *= 2;
+    }
+    std::vector<Slot> old_slots(capacity);
+    old_slots.swap(slots_);
+    for (const Slot& slot : old_slots) {
+        if (slot.tag != 0) {
+            PlaceSlot(slot);
+        }
+    }
+}
+
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::PlaceSlot(const Slot& slot) noexcept {
+    const size_t mask = slots_.size() - 1;
+    size_t index = slot.tag & mask;
+    while (slots_[index].tag != 0) {
+        index = (index + 1) & mask;
+    }
+    slots_[index] = slot;
+}
+
+// Удаление без пометок-надгробий: следующие ячейки той же цепочки проб сдвигаются на освободившееся место
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::RemoveSlot(size_t index) noexcept {
+    const size_t mask = slots_.size() - 1;
+    for (size_t next = (index + 1) & mask; slots_[next].tag != 0; next = (next + 1) & mask) {
+        const size_t home = slots_[next].tag & mask;
+        // Ячейку можно сдвинуть, если её исходная позиция не лежит (циклически) между index и next
+        if (((next - home) & mask) >= ((next - index) & mask)) {
+            slots_[index] = slots_[next];
+            index = next;
+        }
+    }
+    slots_[index] = Slot{};
+}
+
+// Индекс всего списка за один проход
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::RebuildIndex() {
+    slots_.clear();
+    Reserve(GetSize());
+    ConstIterator prev;
+    for (ConstIterator it = begin(); it != end(); prev = it, ++it) {
+        PlaceSlot(Slot{GetTag(*it), prev});
+    }
+}
+
+// Предшественники, перешедшие из встроенных ячеек списка from в те же ячейки list_ (см. ListInlineNodes).
+// Хэши не меняются, поэтому ячейки таблицы остаются на своих местах
+template <typename Type, typename Hash, typename Equal>
+void HashIndexedSingleLinkedList<Type, Hash, Equal>::RelocateSlots(const SingleLinkedList<Type>& from) noexcept {
+    if constexpr (ListInlineNodes<Type>::value > 0) {
+        for (Slot& slot : slots_) {
+            if (slot.tag != 0) {
+                slot.prev = list_.Relocated(slot.prev, from);
+            }
+        }
+    } else {
+        (void)from;
+    }
+}
+
+template <typename Type, typename Hash, typename Equal>
+void swap(HashIndexedSingleLinkedList<Type, Hash, Equal>& lhs,
+          HashIndexedSingleLinkedList<Type, Hash, Equal>& rhs) noexcept {
+    lhs.swap(rhs);
+}
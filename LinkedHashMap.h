@@ -0,0 +1,337 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+#include "SingleLinkedListHash.h"
+
+// Сколько старых корзин переносит каждая вставка и удаление во время перехэширования
+inline constexpr size_t kLinkedHashMapRehashStep = 8;
+
+// Хэш-таблица с цепочками из узлов односвязного списка пар std::pair<const Key, Value>. Корзина - только указатель
+// на первый узел цепочки, а не целый список со своим узлом-заглушкой; все узлы выделяются из одного NodePool.
+// Когда элементов становится больше, чем корзин, таблица удваивается постепенно: старый массив корзин остаётся,
+// и каждая вставка или удаление переносит kLinkedHashMapRehashStep старых корзин в новые, перецепляя узлы
+// без выделения памяти. Поэтому ни одна операция не платит за перехэширование всей таблицы сразу.
+// Ключ корзины, ещё не перенесённой в новый массив, ищется в старой корзине
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class LinkedHashMap {
+public:
+    using value_type = std::pair<const Key, Value>;
+
+    LinkedHashMap() = default;
+    LinkedHashMap(const LinkedHashMap& other);
+    LinkedHashMap(LinkedHashMap&& other) noexcept;
+    ~LinkedHashMap();
+
+    LinkedHashMap& operator=(const LinkedHashMap& rhs);
+    LinkedHashMap& operator=(LinkedHashMap&& rhs) noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] bool IsEmpty() const noexcept {return size_ == 0;}
+    [[nodiscard]] size_t GetBucketCount() const noexcept {return buckets_.size();}
+    // Идёт ли перенос узлов из старого массива корзин
+    [[nodiscard]] bool IsRehashing() const noexcept {return !old_buckets_.empty();}
+
+    // Значение по ключу (nullptr, если ключа нет)
+    [[nodiscard]] Value* Find(const Key& key);
+    [[nodiscard]] const Value* Find(const Key& key) const;
+    [[nodiscard]] bool Contains(const Key& key) const {return Find(key) != nullptr;}
+
+    // Добавляет пару, если ключа ещё нет. Возвращает значение по ключу и признак вставки.
+    // Если выделение памяти или копирование выбросит исключение, пары в таблице остаются прежними
+    std::pair<Value*, bool> Insert(const Key& key, const Value& value);
+    // Добавляет пару или заменяет значение существующего ключа
+    Value& InsertOrAssign(const Key& key, const Value& value);
+    // Удаляет ключ. Возвращает, был ли он
+    bool Erase(const Key& key);
+    void Clear() noexcept;
+    void swap(LinkedHashMap& other) noexcept;
+
+    // Передаёт пары в f(key, value) в порядке корзин
+    template <typename F>
+    void ForEach(F&& f) const;
+
+private:
+    // Узел цепочки хранит перемешанный хэш ключа, как запись LruCache: перехэширование перецепляет узлы,
+    // не вызывая Hash, поэтому не выбрасывает исключений, а поиск сравнивает ключи только при совпадении хэшей
+    struct Node {
+        value_type value;
+        Node* next_node = nullptr;
+        std::uint64_t hash = 0;
+    };
+
+    static constexpr size_t kMinBuckets = 8;
+
+    std::vector<Node*> buckets_;        // Степень двойки; пуст, пока в таблице ничего не было
+    std::vector<Node*> old_buckets_;    // Массив до удвоения; пуст, если перехэширования нет
+    size_t rehash_cursor_ = 0;          // Старые корзины [0, rehash_cursor_) уже перенесены
+    size_t size_ = 0;
+    NodePool<Node> pool_;
+    Hash hash_;
+    Equal equal_;
+
+    [[nodiscard]] std::uint64_t GetHash(const Key& key) const;
+    [[nodiscard]] Node* const& BucketOf(std::uint64_t hash) const noexcept;
+    [[nodiscard]] Node*& BucketOf(std::uint64_t hash) noexcept;
+    [[nodiscard]] Node* FindNode(const Key& key, std::uint64_t hash) const;
+    void Grow();
+    void RehashStep(size_t buckets) noexcept;
+    void Destroy(Node* node) noexcept;
+};
+
+// Узлы копии выделяются в её собственном пуле
+template <typename Key, typename Value, typename Hash, typename Equal>
+LinkedHashMap<Key, Value, Hash, Equal>::LinkedHashMap(const LinkedHashMap& other)
+    : hash_(other.hash_)
+    , equal_(other.equal_) {
+    try {
+        other.ForEach([this](const Key& key, const Value& value) {
+            Insert(key, value);
+        });
+    } catch (...) {
+        Clear();
+        throw;
+    }
+}
+
+// Перемещаются массивы корзин и пул целиком, узлы остаются на месте
+template <typename Key, typename Value, typename Hash, typename Equal>
+LinkedHashMap<Key, Value, Hash, Equal>::LinkedHashMap(LinkedHashMap&& other) noexcept
+    : buckets_(std::move(other.buckets_))
+    , old_buckets_(std::move(other.old_buckets_))
+    , rehash_cursor_(std::exchange(other.rehash_cursor_, 0))
+    , size_(std::exchange(other.size_, 0))
+    , pool_(std::move(other.pool_))
+    , hash_(other.hash_)
+    , equal_(other.equal_) {
+    other.buckets_.clear();
+    other.old_buckets_.clear();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+LinkedHashMap<Key, Value, Hash, Equal>::~LinkedHashMap() {
+    Clear();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+LinkedHashMap<Key, Value, Hash, Equal>& LinkedHashMap<Key, Value, Hash, Equal>::operator=(const LinkedHashMap& rhs) {
+    if (this != &rhs) {
+        LinkedHashMap tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+LinkedHashMap<Key, Value, Hash, Equal>& LinkedHashMap<Key, Value, Hash, Equal>::operator=(
+        LinkedHashMap&& rhs) noexcept {
+    if (this != &rhs) {
+        LinkedHashMap tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] Value* LinkedHashMap<Key, Value, Hash, Equal>::Find(const Key& key) {
+    Node* node = FindNode(key, GetHash(key));
+    return node == nullptr ? nullptr : &node->value.second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] const Value* LinkedHashMap<Key, Value, Hash, Equal>::Find(const Key& key) const {
+    const Node* node = FindNode(key, GetHash(key));
+    return node == nullptr ? nullptr : &node->value.second;
+}
+
+// Удвоение массива корзин - единственное выделение памяти кроме узла, поэтому оно делается до изменения цепочек.
+// Новый узел встаёт в начало корзины, в которой его будет искать Find
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::pair<Value*, bool> LinkedHashMap<Key, Value, Hash, Equal>::Insert(const Key& key, const Value& value) {
+    const std::uint64_t hash = GetHash(key);
+    if (Node* node = FindNode(key, hash); node != nullptr) {
+        return {&node->value.second, false};
+    }
+    if (size_ >= buckets_.size()) {
+        Grow();
+    }
+    Node* node = pool_.Allocate();
+    Node*& bucket = BucketOf(hash);
+    try {
+        new (node) Node{value_type(key, value), bucket, hash};
+    } catch (...) {
+        pool_.Deallocate(node);
+        throw;
+    }
+    bucket = node;
+    ++size_;
+    RehashStep(kLinkedHashMapRehashStep);
+    return {&node->value.second, true};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+Value& LinkedHashMap<Key, Value, Hash, Equal>::InsertOrAssign(const Key& key, const Value& value) {
+    const auto [stored, inserted] = Insert(key, value);
+    if (!inserted) {
+        *stored = value;
+    }
+    return *stored;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool LinkedHashMap<Key, Value, Hash, Equal>::Erase(const Key& key) {
+    if (size_ == 0) {
+        return false;
+    }
+    const std::uint64_t hash = GetHash(key);
+    for (Node** link = &BucketOf(hash); *link != nullptr; link = &(*link)->next_node) {
+        if ((*link)->hash == hash && equal_((*link)->value.first, key)) {
+            Node* node = *link;
+            *link = node->next_node;
+            Destroy(node);
+            --size_;
+            RehashStep(kLinkedHashMapRehashStep);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LinkedHashMap<Key, Value, Hash, Equal>::Clear() noexcept {
+    for (std::vector<Node*>* buckets : {&old_buckets_, &buckets_}) {
+        for (Node* node : *buckets) {
+            while (node != nullptr) {
+                Node* next = node->next_node;
+                Destroy(node);
+                node = next;
+            }
+        }
+    }
+    buckets_.clear();
+    old_buckets_.clear();
+    rehash_cursor_ = 0;
+    size_ = 0;
+    pool_.ReleaseEmptySlabs();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LinkedHashMap<Key, Value, Hash, Equal>::swap(LinkedHashMap& other) noexcept {
+    buckets_.swap(other.buckets_);
+    old_buckets_.swap(other.old_buckets_);
+    std::swap(rehash_cursor_, other.rehash_cursor_);
+    std::swap(size_, other.size_);
+    std::swap(pool_, other.pool_);
+    std::swap(hash_, other.hash_);
+    std::swap(equal_, other.equal_);
+}
+
+// Непереносённые старые корзины обходятся вместе с новыми: каждый узел лежит ровно в одной корзине
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename F>
+void LinkedHashMap<Key, Value, Hash, Equal>::ForEach(F&& f) const {
+    for (size_t i = rehash_cursor_; i < old_buckets_.size(); ++i) {
+        for (const Node* node = old_buckets_[i]; node != nullptr; node = node->next_node) {
+            f(node->value.first, node->value.second);
+        }
+    }
+    for (const Node* node : buckets_) {
+        for (; node != nullptr; node = node->next_node) {
+            f(node->value.first, node->value.second);
+        }
+    }
+}
+
+// Хэш перемешивается, чтобы слабые хэши вроде тождественного std::hash<int> равномерно заполняли корзины
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] std::uint64_t LinkedHashMap<Key, Value, Hash, Equal>::GetHash(const Key& key) const {
+    return list_hash_detail::Mix(static_cast<std::uint64_t>(hash_(key)));
+}
+
+// Корзина ключа с данным хэшем: старая, если её ещё не перенесли, иначе новая
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] typename LinkedHashMap<Key, Value, Hash, Equal>::Node* const& LinkedHashMap<Key, Value, Hash, Equal>::
+        BucketOf(std::uint64_t hash) const noexcept {
+    if (!old_buckets_.empty()) {
+        const size_t old_index = hash & (old_buckets_.size() - 1);
+        if (old_index >= rehash_cursor_) {
+            return old_buckets_[old_index];
+        }
+    }
+    return buckets_[hash & (buckets_.size() - 1)];
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] typename LinkedHashMap<Key, Value, Hash, Equal>::Node*& LinkedHashMap<Key, Value, Hash, Equal>::
+        BucketOf(std::uint64_t hash) noexcept {
+    return const_cast<Node*&>(std::as_const(*this).BucketOf(hash));
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] typename LinkedHashMap<Key, Value, Hash, Equal>::Node* LinkedHashMap<Key, Value, Hash, Equal>::FindNode(
+        const Key& key, std::uint64_t hash) const {
+    if (size_ == 0) {
+        return nullptr;
+    }
+    for (Node* node = BucketOf(hash); node != nullptr; node = node->next_node) {
+        if (node->hash == hash && equal_(node->value.first, key)) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+// Начинает удвоение массива корзин. Незаконченное перехэширование сначала доводится до конца,
+// чтобы старых массивов было не больше одного
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LinkedHashMap<Key, Value, Hash, Equal>::Grow() {
+    if (buckets_.empty()) {
+        buckets_.assign(kMinBuckets, nullptr);
+        return;
+    }
+    std::vector<Node*> buckets(buckets_.size() * 2, nullptr);
+    RehashStep(old_buckets_.size());
+    old_buckets_.swap(buckets_);
+    buckets_.swap(buckets);
+    rehash_cursor_ = 0;
+}
+
+// Переносит до count старых корзин: узлы перецепляются в начало новых корзин, порядок внутри цепочки не важен.
+// Корзина узла считается по сохранённому в нём хэшу, Hash не вызывается
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LinkedHashMap<Key, Value, Hash, Equal>::RehashStep(size_t count) noexcept {
+    const size_t mask = buckets_.size() - 1;
+    for (; count > 0 && rehash_cursor_ < old_buckets_.size(); --count, ++rehash_cursor_) {
+        Node* node = old_buckets_[rehash_cursor_];
+        while (node != nullptr) {
+            Node* next = node->next_node;
+            Node*& bucket = buckets_[node->hash & mask];
+            node->next_node = bucket;
+            bucket = node;
+            node = next;
+        }
+        old_buckets_[rehash_cursor_] = nullptr;
+    }
+    if (rehash_cursor_ == old_buckets_.size() && !old_buckets_.empty()) {
+        std::vector<Node*>().swap(old_buckets_);
+        rehash_cursor_ = 0;
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LinkedHashMap<Key, Value, Hash, Equal>::Destroy(Node* node) noexcept {
+    node->~Node();
+    pool_.Deallocate(node);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void swap(LinkedHashMap<Key, Value, Hash, Equal>& lhs, LinkedHashMap<Key, Value, Hash, Equal>& rhs) noexcept {
+    lhs.swap(rhs);
+}
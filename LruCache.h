@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "NodePool.h"
+#include "SingleLinkedListHash.h"
+
+// Счётчики обращений к LruCache
+struct LruCacheStats {
+    size_t hits = 0;        // Get нашёл ключ
+    size_t misses = 0;      // Get не нашёл ключ
+    size_t evictions = 0;   // Записи, вытесненные при нехватке места
+
+    [[nodiscard]] double GetHitRate() const noexcept {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+// Кэш с вытеснением давно не использованных записей. Записи - узлы односвязного списка от самой свежей
+// к самой старой, память под них выделяет NodePool. Хэш-таблица с открытой адресацией хранит для каждого ключа
+// предшественника его узла, поэтому перенос записи в начало - это O(1) перецепление узла без обхода списка.
+// Когда записей становится больше capacity, самая старая вытесняется; перед её разрушением вызывается
+// on_evict(key, value), который может забрать значение. Вытесненный узел сразу занимает новая запись,
+// так что заполненный кэш не обращается к распределителю памяти
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class LruCache {
+public:
+    using EvictionCallback = std::function<void(const Key& key, Value& value)>;
+
+    explicit LruCache(size_t capacity, EvictionCallback on_evict = {});
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+    ~LruCache();
+
+    // Значение по ключу (nullptr, если его нет). Найденная запись становится самой свежей
+    [[nodiscard]] Value* Get(const Key& key);
+    // Значение без учёта в счётчиках и без изменения порядка
+    [[nodiscard]] const Value* Peek(const Key& key) const;
+    [[nodiscard]] bool Contains(const Key& key) const {return Peek(key) != nullptr;}
+
+    // Добавляет запись или заменяет значение существующей; запись становится самой свежей
+    void Put(const Key& key, const Value& value);
+    // Удаляет запись без вызова on_evict. Возвращает, была ли она
+    bool Erase(const Key& key);
+    void Clear() noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] size_t GetCapacity() const noexcept {return capacity_;}
+    [[nodiscard]] const LruCacheStats& GetStats() const noexcept {return stats_;}
+    void ResetStats() noexcept {stats_ = {};}
+
+    // Передаёт записи в f(key, value) от самой свежей к самой старой
+    template <typename F>
+    void ForEach(F&& f) const;
+
+private:
+    // Перемешанный хэш ключа и номер ячейки таблицы хранятся в узле: перецепление находит ячейки соседних
+    // записей без вычисления хэша и без прохода по цепочке проб
+    struct Entry {
+        Entry* next;
+        std::uint64_t tag;
+        size_t slot;
+        Key key;
+        Value value;
+    };
+
+    // Ячейка таблицы: хэш со старшим битом-признаком занятости и предшественник записи (nullptr - запись первая)
+    struct Slot {
+        std::uint64_t tag = 0;
+        Entry* prev = nullptr;
+    };
+
+    static constexpr std::uint64_t kOccupied = std::uint64_t{1} << 63;
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+    Entry* first_ = nullptr;        // Самая свежая запись
+    Entry* last_ = nullptr;         // Самая старая запись
+    std::vector<Slot> slots_;       // Степень двойки, не меньше 4/3 capacity: таблица никогда не растёт
+    NodePool<Entry> pool_;
+    EvictionCallback on_evict_;
+    LruCacheStats stats_;
+    Hash hash_;
+    Equal equal_;
+
+    [[nodiscard]] std::uint64_t GetTag(const Key& key) const;
+    [[nodiscard]] Entry*& NextOf(Entry* prev) noexcept {return prev == nullptr ? first_ : prev->next;}
+    [[nodiscard]] Entry* EntryOf(const Slot& slot) const noexcept {return slot.prev == nullptr ? first_ : slot.prev->next;}
+    [[nodiscard]] size_t FindSlot(const Key& key, std::uint64_t tag) const;
+    void PlaceSlot(Entry* entry) noexcept;
+    void RemoveSlot(size_t index) noexcept;
+    void MoveToFront(size_t index) noexcept;
+    void LinkFront(Entry* entry) noexcept;
+    [[nodiscard]] Entry* UnlinkLast() noexcept;
+    void DestroyEntry(Entry* entry) noexcept;
+};
+
+// Таблица выделяется сразу под capacity записей: заполненная не больше чем на 3/4, она даёт короткие цепочки проб
+template <typename Key, typename Value, typename Hash, typename Equal>
+LruCache<Key, Value, Hash, Equal>::LruCache(size_t capacity, EvictionCallback on_evict)
+    : capacity_(capacity)
+    , on_evict_(std::move(on_evict)) {
+    assert(capacity > 0);
+    size_t table_size = 8;
+    while (table_size * 3 < capacity * 4) {
+        table_size *= 2;
+    }
+    slots_.resize(table_size);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+LruCache<Key, Value, Hash, Equal>::~LruCache() {
+    Clear();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] Value* LruCache<Key, Value, Hash, Equal>::Get(const Key& key) {
+    const size_t index = FindSlot(key, GetTag(key));
+    if (index == kNotFound) {
+        ++stats_.misses;
+        return nullptr;
+    }
+    ++stats_.hits;
+    MoveToFront(index);
+    return &first_->value;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] const Value* LruCache<Key, Value, Hash, Equal>::Peek(const Key& key) const {
+    const size_t index = FindSlot(key, GetTag(key));
+    return index == kNotFound ? nullptr : &EntryOf(slots_[index])->value;
+}
+
+// В заполненном кэше новая запись строится в узле вытесненной. Если копирование ключа или значения
+// выбросит исключение, узел возвращается в пул, а вытесненная запись остаётся вытесненной
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::Put(const Key& key, const Value& value) {
+    const std::uint64_t tag = GetTag(key);
+    if (const size_t index = FindSlot(key, tag); index != kNotFound) {
+        EntryOf(slots_[index])->value = value;
+        MoveToFront(index);
+        return;
+    }
+
+    Entry* entry = nullptr;
+    if (size_ == capacity_) {
+        entry = UnlinkLast();
+        ++stats_.evictions;
+        try {
+            if (on_evict_) {
+                on_evict_(entry->key, entry->value);
+            }
+        } catch (...) {
+            DestroyEntry(entry);
+            throw;
+        }
+        entry->~Entry();
+    } else {
+        entry = pool_.Allocate();
+    }
+    try {
+        new (entry) Entry{nullptr, tag, 0, key, value};
+    } catch (...) {
+        pool_.Deallocate(entry);
+        throw;
+    }
+    LinkFront(entry);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool LruCache<Key, Value, Hash, Equal>::Erase(const Key& key) {
+    const size_t index = FindSlot(key, GetTag(key));
+    if (index == kNotFound) {
+        return false;
+    }
+    Entry* prev = slots_[index].prev;
+    Entry* entry = NextOf(prev);
+    Entry* next = entry->next;
+    NextOf(prev) = next;
+    if (next != nullptr) {
+        slots_[next->slot].prev = prev;
+    } else {
+        last_ = prev;
+    }
+    RemoveSlot(index);
+    --size_;
+    DestroyEntry(entry);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::Clear() noexcept {
+    while (first_ != nullptr) {
+        Entry* next = first_->next;
+        DestroyEntry(first_);
+        first_ = next;
+    }
+    last_ = nullptr;
+    size_ = 0;
+    std::fill(slots_.begin(), slots_.end(), Slot{});
+    pool_.ReleaseEmptySlabs();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename F>
+void LruCache<Key, Value, Hash, Equal>::ForEach(F&& f) const {
+    for (const Entry* entry = first_; entry != nullptr; entry = entry->next) {
+        f(entry->key, entry->value);
+    }
+}
+
+// Хэш перемешивается, чтобы слабые хэши вроде тождественного std::hash<int> не давали длинных цепочек проб
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] std::uint64_t LruCache<Key, Value, Hash, Equal>::GetTag(const Key& key) const {
+    return list_hash_detail::Mix(static_cast<std::uint64_t>(hash_(key))) | kOccupied;
+}
+
+// Ячейка записи с ключом key (kNotFound, если записи нет)
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] size_t LruCache<Key, Value, Hash, Equal>::FindSlot(const Key& key, std::uint64_t tag) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = tag & mask; slots_[index].tag != 0; index = (index + 1) & mask) {
+        if (slots_[index].tag == tag && equal_(EntryOf(slots_[index])->key, key)) {
+            return index;
+        }
+    }
+    return kNotFound;
+}
+
+// Занимает ячейку для записи entry, которая только что стала первой
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::PlaceSlot(Entry* entry) noexcept {
+    const size_t mask = slots_.size() - 1;
+    size_t index = entry->tag & mask;
+    while (slots_[index].tag != 0) {
+        index = (index + 1) & mask;
+    }
+    slots_[index] = Slot{entry->tag, nullptr};
+    entry->slot = index;
+}
+
+// Удаление без пометок-надгробий: следующие ячейки той же цепочки проб сдвигаются на освободившееся место,
+// а их записи запоминают новые номера ячеек. Список к этому моменту уже перецеплен
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::RemoveSlot(size_t index) noexcept {
+    const size_t mask = slots_.size() - 1;
+    for (size_t next = (index + 1) & mask; slots_[next].tag != 0; next = (next + 1) & mask) {
+        const size_t home = slots_[next].tag & mask;
+        if (((next - home) & mask) >= ((next - index) & mask)) {
+            slots_[index] = slots_[next];
+            EntryOf(slots_[index])->slot = index;
+            index = next;
+        }
+    }
+    slots_[index] = Slot{};
+}
+
+// Переносит запись из ячейки index в начало списка. Меняются предшественники трёх записей:
+// самой перенесённой, следующей за ней и бывшей первой
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::MoveToFront(size_t index) noexcept {
+    Entry* prev = slots_[index].prev;
+    if (prev == nullptr) {
+        return;
+    }
+    Entry* entry = prev->next;
+    Entry* next = entry->next;
+    prev->next = next;
+    if (next != nullptr) {
+        slots_[next->slot].prev = prev;
+    } else {
+        last_ = prev;
+    }
+    slots_[first_->slot].prev = entry;
+    entry->next = first_;
+    first_ = entry;
+    slots_[index].prev = nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::LinkFront(Entry* entry) noexcept {
+    if (first_ != nullptr) {
+        slots_[first_->slot].prev = entry;
+    } else {
+        last_ = entry;
+    }
+    entry->next = first_;
+    first_ = entry;
+    PlaceSlot(entry);
+    ++size_;
+}
+
+// Отцепляет самую старую запись от списка и таблицы, но не разрушает её
+template <typename Key, typename Value, typename Hash, typename Equal>
+[[nodiscard]] typename LruCache<Key, Value, Hash, Equal>::Entry* LruCache<Key, Value, Hash, Equal>::UnlinkLast() noexcept {
+    Entry* entry = last_;
+    const size_t index = entry->slot;
+    last_ = slots_[index].prev;
+    NextOf(last_) = nullptr;
+    RemoveSlot(index);
+    --size_;
+    return entry;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void LruCache<Key, Value, Hash, Equal>::DestroyEntry(Entry* entry) noexcept {
+    entry->~Entry();
+    pool_.Deallocate(entry);
+}
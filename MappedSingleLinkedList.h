@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SINGLE_LINKED_LIST_HAS_MMAP 1
+#else
+#define SINGLE_LINKED_LIST_HAS_MMAP 0
+#endif
+
+#include "SingleLinkedList.h"
+
+// Список, записанный в файл в виде, пригодном для отображения в память (mmap) и обхода без разбора.
+// Формат: заголовок MappedListHeader, затем записи {смещение следующей записи, значение}.
+// Смещение отсчитывается от начала текущей записи, 0 - конец списка; поэтому файл не зависит
+// от адреса, по которому он отображён. Числа хранятся в порядке байт платформы, записавшей файл.
+// Годится только для значений, которые записываются побайтово (ListValueCodec<Type>::kBitwise)
+struct MappedListHeader {
+    static constexpr char kMagic[4] = {'S', 'L', 'L', 'M'};
+
+    char magic[4] = {kMagic[0], kMagic[1], kMagic[2], kMagic[3]};
+    std::uint32_t value_size = 0;       // sizeof(Type)
+    std::uint32_t record_size = 0;      // Размер записи с выравниванием
+    std::uint32_t record_alignment = 0; // Выравнивание записи
+    std::uint64_t count = 0;            // Количество элементов
+    std::uint64_t first_offset = 0;     // Смещение первой записи от начала файла (0 - список пуст)
+};
+
+// Представление только для чтения над отображённым файлом или буфером в памяти.
+// Итерация не копирует значения и не выделяет память: страницы файла подгружаются по мере обхода
+template <typename Type>
+class MappedSingleLinkedList {
+    static_assert(ListValueCodec<Type>::kBitwise, "MappedSingleLinkedList requires bitwise-serializable values");
+
+    // Запись файла
+    struct Record {
+        std::int64_t next = 0;
+        Type value;
+    };
+
+public:
+    class ConstIterator;
+
+    using value_type = Type;
+    using reference = const Type&;
+    using const_reference = const Type&;
+    using iterator = ConstIterator;
+    using const_iterator = ConstIterator;
+
+    MappedSingleLinkedList() = default;
+    MappedSingleLinkedList(const void* data, size_t size);  // Представление над чужим буфером (не владеет им)
+    MappedSingleLinkedList(const MappedSingleLinkedList&) = delete;
+    MappedSingleLinkedList& operator=(const MappedSingleLinkedList&) = delete;
+    MappedSingleLinkedList(MappedSingleLinkedList&& other) noexcept;
+    MappedSingleLinkedList& operator=(MappedSingleLinkedList&& rhs) noexcept;
+    ~MappedSingleLinkedList();
+
+    // Отображает файл в память. Ошибки открытия и неверный заголовок - исключение std::runtime_error
+    [[nodiscard]] static MappedSingleLinkedList Open(const std::string& path);
+
+    // Записывает список в формате для отображения в память, записи идут в порядке обхода
+    static void Write(const SingleLinkedList<Type>& list, std::ostream& out);
+    static void Write(const SingleLinkedList<Type>& list, const std::string& path);
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] bool IsEmpty() const noexcept {return size_ == 0;}
+
+    // Проверяет за O(N), что все смещения указывают внутрь файла, а длина цепочки совпадает с заголовком.
+    // Open проверяет только заголовок: для файлов из ненадёжных источников перед обходом нужен Validate
+    [[nodiscard]] bool Validate() const noexcept;
+
+    [[nodiscard]] ConstIterator begin() const noexcept {return ConstIterator(first_);}
+    [[nodiscard]] ConstIterator end() const noexcept {return ConstIterator(nullptr);}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+
+    void swap(MappedSingleLinkedList& other) noexcept;
+
+private:
+    const char* data_ = nullptr;
+    size_t bytes_ = 0;
+    const char* first_ = nullptr;
+    size_t size_ = 0;
+    bool owns_mapping_ = false;
+
+    [[nodiscard]] static constexpr size_t FirstRecordOffset() noexcept {
+        return (sizeof(MappedListHeader) + alignof(Record) - 1) / alignof(Record) * alignof(Record);
+    }
+};
+
+// Итератор по записям. По интерфейсу совпадает с SingleLinkedList<Type>::ConstIterator
+template <typename Type>
+class MappedSingleLinkedList<Type>::ConstIterator {
+    friend class MappedSingleLinkedList<Type>;
+
+    explicit ConstIterator(const char* record) noexcept : record_(record) {}
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Type*;
+    using reference = const Type&;
+
+    ConstIterator() = default;
+
+    [[nodiscard]] bool operator==(const ConstIterator& rhs) const noexcept {return record_ == rhs.record_;}
+    [[nodiscard]] bool operator!=(const ConstIterator& rhs) const noexcept {return record_ != rhs.record_;}
+
+    ConstIterator& operator++() noexcept {
+        const std::int64_t next = GetRecord()->next;
+        record_ = next == 0 ? nullptr : record_ + next;
+        return *this;
+    }
+
+    ConstIterator operator++(int) noexcept {
+        auto old_value(*this);
+        ++(*this);
+        return old_value;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {return GetRecord()->value;}
+    [[nodiscard]] pointer operator->() const noexcept {return &GetRecord()->value;}
+
+private:
+    const char* record_ = nullptr;
+
+    [[nodiscard]] const Record* GetRecord() const noexcept {
+        return reinterpret_cast<const Record*>(record_);
+    }
+};
+
+// Представление над буфером. Буфер должен быть выровнен не хуже записей и жить дольше представления
+template <typename Type>
+MappedSingleLinkedList<Type>::MappedSingleLinkedList(const void* data, size_t size)
+    : data_(static_cast<const char*>(data))
+    , bytes_(size) {
+    if (size < sizeof(MappedListHeader)) {
+        throw std::runtime_error("MappedSingleLinkedList: file is too small");
+    }
+    MappedListHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, MappedListHeader::kMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("MappedSingleLinkedList: bad header");
+    }
+    if (header.value_size != sizeof(Type) || header.record_size != sizeof(Record)
+        || header.record_alignment != alignof(Record)) {
+        throw std::runtime_error("MappedSingleLinkedList: value type mismatch");
+    }
+    if (reinterpret_cast<std::uintptr_t>(data_) % alignof(Record) != 0) {
+        throw std::runtime_error("MappedSingleLinkedList: misaligned buffer");
+    }
+    if ((header.count == 0) != (header.first_offset == 0)
+        || header.first_offset % alignof(Record) != 0
+        || (header.count != 0 && (header.first_offset > size || size - header.first_offset < sizeof(Record)))) {
+        throw std::runtime_error("MappedSingleLinkedList: bad first record offset");
+    }
+    size_ = static_cast<size_t>(header.count);
+    first_ = size_ == 0 ? nullptr : data_ + header.first_offset;
+}
+
+template <typename Type>
+MappedSingleLinkedList<Type>::MappedSingleLinkedList(MappedSingleLinkedList&& other) noexcept {
+    swap(other);
+}
+
+template <typename Type>
+MappedSingleLinkedList<Type>& MappedSingleLinkedList<Type>::operator=(MappedSingleLinkedList&& rhs) noexcept {
+    if (this != &rhs) {
+        MappedSingleLinkedList tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename Type>
+MappedSingleLinkedList<Type>::~MappedSingleLinkedList() {
+#if SINGLE_LINKED_LIST_HAS_MMAP
+    if (owns_mapping_) {
+        munmap(const_cast<char*>(data_), bytes_);
+    }
+#endif
+}
+
+template <typename Type>
+void MappedSingleLinkedList<Type>::swap(MappedSingleLinkedList& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(bytes_, other.bytes_);
+    std::swap(first_, other.first_);
+    std::swap(size_, other.size_);
+    std::swap(owns_mapping_, other.owns_mapping_);
+}
+
+// Файл отображается целиком только для чтения; физически читаются лишь страницы, которых коснётся обход
+template <typename Type>
+[[nodiscard]] MappedSingleLinkedList<Type> MappedSingleLinkedList<Type>::Open(const std::string& path) {
+#if SINGLE_LINKED_LIST_HAS_MMAP
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("MappedSingleLinkedList: cannot open " + path + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("MappedSingleLinkedList: cannot stat " + path);
+    }
+    const size_t bytes = static_cast<size_t>(info.st_size);
+    if (bytes < sizeof(MappedListHeader)) {
+        close(fd);
+        throw std::runtime_error("MappedSingleLinkedList: file is too small: " + path);
+    }
+    void* data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Отображение остаётся действительным и после закрытия дескриптора
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("MappedSingleLinkedList: cannot map " + path);
+    }
+    try {
+        MappedSingleLinkedList result(data, bytes);
+        result.owns_mapping_ = true;
+        return result;
+    } catch (...) {
+        munmap(data, bytes);
+        throw;
+    }
+#else
+    throw std::runtime_error("MappedSingleLinkedList: memory mapping is not supported on this platform: " + path);
+#endif
+}
+
+// Записи пишутся блоками; байты выравнивания внутри записей обнуляются, чтобы файл был воспроизводимым
+template <typename Type>
+void MappedSingleLinkedList<Type>::Write(const SingleLinkedList<Type>& list, std::ostream& out) {
+    MappedListHeader header;
+    header.value_size = sizeof(Type);
+    header.record_size = sizeof(Record);
+    header.record_alignment = alignof(Record);
+    header.count = list.GetSize();
+    header.first_offset = list.IsEmpty() ? 0 : FirstRecordOffset();
+
+    std::vector<char> chunk(FirstRecordOffset(), 0);
+    std::memcpy(chunk.data(), &header, sizeof(header));
+    constexpr size_t kChunkBytes = 64 << 10;
+    const auto flush = [&] {
+        if (!out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()))) {
+            throw std::runtime_error("MappedSingleLinkedList: write failed");
+        }
+        chunk.clear();
+    };
+
+    size_t left = list.GetSize();
+    for (const Type& value : list) {
+        const size_t offset = chunk.size();
+        chunk.resize(offset + sizeof(Record), 0);
+        const std::int64_t next = --left == 0 ? 0 : static_cast<std::int64_t>(sizeof(Record));
+        std::memcpy(chunk.data() + offset + offsetof(Record, next), &next, sizeof(next));
+        std::memcpy(chunk.data() + offset + offsetof(Record, value), &value, sizeof(Type));
+        if (chunk.size() >= kChunkBytes) {
+            flush();
+        }
+    }
+    flush();
+}
+
+template <typename Type>
+void MappedSingleLinkedList<Type>::Write(const SingleLinkedList<Type>& list, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("MappedSingleLinkedList: cannot create " + path);
+    }
+    Write(list, out);
+}
+
+template <typename Type>
+[[nodiscard]] bool MappedSingleLinkedList<Type>::Validate() const noexcept {
+    size_t visited = 0;
+    for (const char* record = first_; record != nullptr; ++visited) {
+        const size_t offset = static_cast<size_t>(record - data_);
+        if (visited == size_ || offset % alignof(Record) != 0 || offset > bytes_ || bytes_ - offset < sizeof(Record)) {
+            return false;
+        }
+        std::int64_t next = 0;
+        std::memcpy(&next, record + offsetof(Record, next), sizeof(next));
+        if (next == 0) {
+            record = nullptr;
+        } else if ((next < 0 && static_cast<std::uint64_t>(-(next + 1)) >= offset)
+                   || (next > 0 && static_cast<std::uint64_t>(next) >= bytes_ - offset)) {
+            return false;
+        } else {
+            record += next;
+        }
+    }
+    return visited == size_;
+}
+
+template <typename Type>
+void swap(MappedSingleLinkedList<Type>& lhs, MappedSingleLinkedList<Type>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Оценка размера блока, который выделит malloc под запрос requested байт:
+// служебное слово перед блоком и выравнивание до 16 байт (минимум 32 байта, как в glibc)
+[[nodiscard]] constexpr size_t EstimateMallocChunkSize(size_t requested) noexcept {
+    const size_t chunk = (requested + sizeof(size_t) + 15) & ~size_t{15};
+    return chunk < 32 ? 32 : chunk;
+}
+
+// Пул ячеек под объекты типа T, выделяемых блоками (слабами).
+// Ячейки одного слаба лежат в памяти подряд с шагом sizeof(T), поэтому объекты,
+// размещённые в слабе по порядку, можно обходить как массив.
+// Пул управляет только памятью: конструировать и разрушать объекты должен владелец пула
+template <typename T>
+class NodePool {
+    // Свободная ячейка хранит указатель на следующую свободную ячейку своего слаба
+    union Slot {
+        Slot* next_free;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct Slab {
+        std::unique_ptr<Slot[]> slots;
+        size_t capacity = 0;
+        size_t used = 0;            // Ячейки [0, used) хотя бы раз выдавались
+        size_t live = 0;            // Ячейки, занятые в данный момент
+        Slot* free_list = nullptr;  // Возвращённые ячейки
+
+        [[nodiscard]] bool Contains(const void* p) const noexcept {
+            return std::less_equal<const void*>{}(slots.get(), p)
+                && std::less<const void*>{}(p, slots.get() + capacity);
+        }
+    };
+
+public:
+    static_assert(sizeof(Slot) == sizeof(T), "NodePool slots must be laid out as an array of T");
+
+    // Размеры слабов, создаваемых Allocate: начиная с kMinSlabCapacity, с удвоением
+    static constexpr size_t kMinSlabCapacity = 16;
+    static constexpr size_t kMaxSlabCapacity = 4096;
+
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool(NodePool&&) noexcept = default;
+    NodePool& operator=(NodePool&&) noexcept = default;
+
+    [[nodiscard]] T* Allocate();                            // Выделяет одну ячейку
+    [[nodiscard]] T* AllocateSlab(size_t count);            // Выделяет count ячеек подряд в новом слабе
+    [[nodiscard]] T* AllocateRun(size_t count, size_t max_capacity);  // Выделяет count ячеек подряд, растя слабы вдвое
+    void Deallocate(T* p) noexcept;                         // Возвращает ячейку в пул
+    void DeallocateAll() noexcept;                          // Возвращает в пул все ячейки сразу
+    [[nodiscard]] bool Owns(const T* p) const noexcept;     // Принадлежит ли ячейка пулу
+    size_t ReleaseEmptySlabs() noexcept;                    // Освобождает слабы без занятых ячеек
+    void Merge(NodePool&& other);                           // Забирает все слабы other
+
+    [[nodiscard]] size_t GetSlabCount() const noexcept {return slabs_.size();}
+    [[nodiscard]] size_t GetLiveCount() const noexcept;
+    [[nodiscard]] size_t GetCapacity() const noexcept;
+    [[nodiscard]] size_t GetReservedBytes() const noexcept; // Память, занятая слабами, включая служебную
+    [[nodiscard]] size_t GetBookkeepingBytes() const noexcept;  // Память под описания слабов
+
+    // Память, которую занимает в куче слаб на count ячеек
+    [[nodiscard]] static constexpr size_t SlabBytes(size_t count) noexcept {
+        return EstimateMallocChunkSize(count * sizeof(Slot));
+    }
+
+private:
+    std::vector<Slab> slabs_;               // В порядке создания: последний слаб - самый новый
+    std::vector<size_t> slabs_by_address_;  // Номера слабов по возрастанию адреса ячеек, для двоичного поиска
+    // Слаб, в котором нашлась последняя ячейка: соседние узлы списка обычно лежат в одном слабе,
+    // поэтому двоичный поиск по слабам нужен редко
+    mutable size_t last_slab_ = 0;
+
+    [[nodiscard]] const Slab* FindSlabCached(const void* p) const noexcept;
+
+    [[nodiscard]] Slab* FindSlab(const void* p) noexcept;
+    Slab& AddSlab(size_t capacity);
+    void SortSlabsByAddress() noexcept;
+};
+
+// Выделяет одну ячейку: сначала из свободных ячеек и неиспользованного хвоста последних слабов,
+// затем из нового слаба, вдвое большего предыдущего
+template <typename T>
+[[nodiscard]] T* NodePool<T>::Allocate() {
+    for (auto it = slabs_.rbegin(); it != slabs_.rend(); ++it) {
+        Slab& slab = *it;
+        if (slab.free_list != nullptr) {
+            Slot* slot = slab.free_list;
+            slab.free_list = slot->next_free;
+            ++slab.live;
+            return reinterpret_cast<T*>(slot->storage);
+        }
+        if (slab.used < slab.capacity) {
+            ++slab.live;
+            return reinterpret_cast<T*>(slab.slots[slab.used++].storage);
+        }
+    }
+    const size_t capacity = slabs_.empty()
+        ? kMinSlabCapacity
+        : std::min(slabs_.back().capacity * 2, kMaxSlabCapacity);
+    Slab& slab = AddSlab(std::max(capacity, kMinSlabCapacity));
+    slab.used = slab.live = 1;
+    return reinterpret_cast<T*>(slab.slots[0].storage);
+}
+
+// Выделяет count ячеек, идущих подряд, в новом слабе. Все ячейки считаются занятыми;
+// неиспользованные вызывающий возвращает через Deallocate
+template <typename T>
+[[nodiscard]] T* NodePool<T>::AllocateSlab(size_t count) {
+    assert(count > 0);
+    Slab& slab = AddSlab(count);
+    slab.used = slab.live = count;
+    return reinterpret_cast<T*>(slab.slots[0].storage);
+}
+
+// Выделяет count ячеек, идущих подряд, продолжая неиспользованный хвост самого нового слаба:
+// ячейки, выделенные несколькими вызовами подряд, тоже лежат в памяти подряд. Если хвост мал,
+// создаёт слаб вдвое больше прежнего (но не больше max_capacity и не меньше count), поэтому
+// много коротких запросов обходятся O(log N) слабами. Все ячейки считаются занятыми;
+// неиспользованные вызывающий возвращает через Deallocate
+template <typename T>
+[[nodiscard]] T* NodePool<T>::AllocateRun(size_t count, size_t max_capacity) {
+    assert(count > 0);
+    if (!slabs_.empty()) {
+        Slab& slab = slabs_.back();
+        if (slab.capacity - slab.used >= count) {
+            Slot* first = &slab.slots[slab.used];
+            slab.used += count;
+            slab.live += count;
+            return reinterpret_cast<T*>(first->storage);
+        }
+    }
+    const size_t grown = slabs_.empty() ? kMinSlabCapacity : std::min(slabs_.back().capacity, SIZE_MAX / 2) * 2;
+    Slab& slab = AddSlab(std::max(std::min(grown, max_capacity), count));
+    slab.used = slab.live = count;
+    return reinterpret_cast<T*>(slab.slots[0].storage);
+}
+
+// Возвращает ячейку в свободный список её слаба. Объект в ячейке должен быть уже разрушен
+template <typename T>
+void NodePool<T>::Deallocate(T* p) noexcept {
+    Slab* slab = FindSlab(p);
+    assert(slab != nullptr && slab->live > 0);
+    Slot* slot = reinterpret_cast<Slot*>(p);
+    slot->next_free = slab->free_list;
+    slab->free_list = slot;
+    --slab->live;
+}
+
+// Считает свободными все ячейки всех слабов, не трогая их содержимое. Объекты в ячейках
+// должны быть уже разрушены или не нуждаться в разрушении
+template <typename T>
+void NodePool<T>::DeallocateAll() noexcept {
+    for (Slab& slab : slabs_) {
+        slab.used = slab.live = 0;
+        slab.free_list = nullptr;
+    }
+}
+
+template <typename T>
+[[nodiscard]] bool NodePool<T>::Owns(const T* p) const noexcept {
+    return FindSlabCached(p) != nullptr;
+}
+
+// Освобождает слабы, в которых не осталось занятых ячеек. Возвращает количество освобождённых байт
+template <typename T>
+size_t NodePool<T>::ReleaseEmptySlabs() noexcept {
+    size_t released = 0;
+    auto kept = slabs_.begin();
+    for (auto it = slabs_.begin(); it != slabs_.end(); ++it) {
+        if (it->live == 0) {
+            released += SlabBytes(it->capacity);
+        } else {
+            if (kept != it) {
+                *kept = std::move(*it);
+            }
+            ++kept;
+        }
+    }
+    if (kept != slabs_.end()) {
+        slabs_.erase(kept, slabs_.end());
+        SortSlabsByAddress();
+    }
+    return released;
+}
+
+// Забирает все слабы other вместе с занятыми в них ячейками
+template <typename T>
+void NodePool<T>::Merge(NodePool&& other) {
+    slabs_.reserve(slabs_.size() + other.slabs_.size());
+    slabs_by_address_.reserve(slabs_.size() + other.slabs_.size());
+    for (Slab& slab : other.slabs_) {
+        slabs_.push_back(std::move(slab));
+    }
+    other.slabs_.clear();
+    other.slabs_by_address_.clear();
+    SortSlabsByAddress();
+}
+
+template <typename T>
+[[nodiscard]] size_t NodePool<T>::GetLiveCount() const noexcept {
+    size_t live = 0;
+    for (const Slab& slab : slabs_) {
+        live += slab.live;
+    }
+    return live;
+}
+
+template <typename T>
+[[nodiscard]] size_t NodePool<T>::GetCapacity() const noexcept {
+    size_t capacity = 0;
+    for (const Slab& slab : slabs_) {
+        capacity += slab.capacity;
+    }
+    return capacity;
+}
+
+template <typename T>
+[[nodiscard]] size_t NodePool<T>::GetReservedBytes() const noexcept {
+    size_t bytes = 0;
+    for (const Slab& slab : slabs_) {
+        bytes += SlabBytes(slab.capacity);
+    }
+    return bytes;
+}
+
+template <typename T>
+[[nodiscard]] size_t NodePool<T>::GetBookkeepingBytes() const noexcept {
+    const auto vector_bytes = [](const auto& vector) {
+        return vector.capacity() == 0 ? 0 : EstimateMallocChunkSize(vector.capacity() * sizeof(vector[0]));
+    };
+    return vector_bytes(slabs_) + vector_bytes(slabs_by_address_);
+}
+
+template <typename T>
+[[nodiscard]] typename NodePool<T>::Slab* NodePool<T>::FindSlab(const void* p) noexcept {
+    return const_cast<Slab*>(FindSlabCached(p));
+}
+
+template <typename T>
+[[nodiscard]] const typename NodePool<T>::Slab* NodePool<T>::FindSlabCached(const void* p) const noexcept {
+    if (last_slab_ < slabs_.size() && slabs_[last_slab_].Contains(p)) {
+        return &slabs_[last_slab_];
+    }
+    // Последний слаб, начинающийся не выше p
+    const auto above = std::upper_bound(slabs_by_address_.begin(), slabs_by_address_.end(), p,
+                                        [this](const void* address, size_t i) {
+                                            return std::less<const void*>{}(address, slabs_[i].slots.get());
+                                        });
+    if (above == slabs_by_address_.begin() || !slabs_[*std::prev(above)].Contains(p)) {
+        return nullptr;
+    }
+    last_slab_ = *std::prev(above);
+    return &slabs_[last_slab_];
+}
+
+template <typename T>
+typename NodePool<T>::Slab& NodePool<T>::AddSlab(size_t capacity) {
+    Slab slab;
+    slab.slots.reset(new Slot[capacity]);
+    slab.capacity = capacity;
+    slabs_by_address_.reserve(slabs_.size() + 1);
+    slabs_.push_back(std::move(slab));
+    const Slot* slots = slabs_.back().slots.get();
+    const auto above = std::upper_bound(slabs_by_address_.begin(), slabs_by_address_.end(), slots,
+                                        [this](const Slot* address, size_t i) {
+                                            return std::less<const Slot*>{}(address, slabs_[i].slots.get());
+                                        });
+    slabs_by_address_.insert(above, slabs_.size() - 1);
+    return slabs_.back();
+}
+
+// Перестраивает порядок слабов по адресу после удаления или добавления нескольких слабов сразу.
+// Память под slabs_by_address_ зарезервирована заранее, поэтому исключений нет
+template <typename T>
+void NodePool<T>::SortSlabsByAddress() noexcept {
+    slabs_by_address_.resize(slabs_.size());
+    std::iota(slabs_by_address_.begin(), slabs_by_address_.end(), size_t{0});
+    std::sort(slabs_by_address_.begin(), slabs_by_address_.end(), [this](size_t lhs, size_t rhs) {
+        return std::less<const Slot*>{}(slabs_[lhs].slots.get(), slabs_[rhs].slots.get());
+    });
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SingleLinkedList.h"
+
+// Разреженный индекс разбиения: итераторы на каждый stride-й элемент диапазона.
+// Позволяет поделить список на независимые куски без повторного последовательного обхода.
+// Индекс не отслеживает изменения списка: после вставок и удалений его нужно перестроить (Rebuild)
+template <typename It>
+class SplitIndex {
+public:
+    SplitIndex() = default;
+    SplitIndex(It first, It last, size_t stride);
+
+    void Rebuild(It first, It last, size_t stride);     // Перестраивает индекс за время O(N)
+
+    [[nodiscard]] size_t GetStride() const noexcept {return stride_;}
+    [[nodiscard]] size_t GetChunkCount() const noexcept {return checkpoints_.size();}
+    [[nodiscard]] size_t GetElementCount() const noexcept {return element_count_;}
+
+    // Начало и конец i-го куска
+    [[nodiscard]] It ChunkBegin(size_t i) const noexcept {return checkpoints_[i];}
+    [[nodiscard]] It ChunkEnd(size_t i) const noexcept {
+        return i + 1 < checkpoints_.size() ? checkpoints_[i + 1] : last_;
+    }
+
+private:
+    std::vector<It> checkpoints_;
+    It last_ = {};
+    size_t stride_ = 0;
+    size_t element_count_ = 0;
+};
+
+template <typename It>
+SplitIndex<It>::SplitIndex(It first, It last, size_t stride) {
+    Rebuild(first, last, stride);
+}
+
+// Перестраивает индекс за время O(N)
+template <typename It>
+void SplitIndex<It>::Rebuild(It first, It last, size_t stride) {
+    assert(stride > 0);
+    checkpoints_.clear();
+    last_ = last;
+    stride_ = stride;
+    element_count_ = 0;
+    for (; first != last; ++first, ++element_count_) {
+        if (element_count_ % stride == 0) {
+            checkpoints_.push_back(first);
+        }
+    }
+}
+
+// Пул потоков фиксированного размера для параллельных алгоритмов над списками.
+// Выполняет пакет из tasks независимых задач; вызывающий поток участвует в работе
+class ParallelExecutor {
+public:
+    explicit ParallelExecutor(size_t thread_count = std::max(1u, std::thread::hardware_concurrency()));
+    ParallelExecutor(const ParallelExecutor&) = delete;
+    ParallelExecutor& operator=(const ParallelExecutor&) = delete;
+    ~ParallelExecutor();
+
+    // Количество потоков, включая вызывающий
+    [[nodiscard]] size_t GetThreadCount() const noexcept {return workers_.size() + 1;}
+
+    // Вызывает task(i) для каждого i из [0, tasks) и дожидается завершения всех вызовов.
+    // Первое выброшенное задачей исключение пробрасывается вызывающему
+    template <typename Task>
+    void Run(size_t tasks, Task&& task);
+
+    // Общий пул с числом потоков по количеству ядер
+    [[nodiscard]] static ParallelExecutor& Default();
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    // Пакет, выполняемый в данный момент
+    std::function<void(size_t)> job_;
+    size_t job_size_ = 0;
+    std::atomic<size_t> next_task_{0};
+    size_t busy_workers_ = 0;
+    size_t generation_ = 0;
+    std::exception_ptr error_;
+    bool stopping_ = false;
+    // Параллельные пакеты от разных потоков выполняются по очереди
+    std::mutex run_mutex_;
+
+    void WorkerLoop();
+    void DrainTasks() noexcept;
+};
+
+inline ParallelExecutor::ParallelExecutor(size_t thread_count) {
+    for (size_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+inline ParallelExecutor::~ParallelExecutor() {
+    {
+        std::lock_guard guard(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+template <typename Task>
+void ParallelExecutor::Run(size_t tasks, Task&& task) {
+    if (tasks == 0) {
+        return;
+    }
+    if (workers_.empty() || tasks == 1) {
+        for (size_t i = 0; i < tasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard run_guard(run_mutex_);
+    {
+        std::lock_guard guard(mutex_);
+        job_ = std::ref(task);
+        job_size_ = tasks;
+        next_task_.store(0, std::memory_order_relaxed);
+        error_ = nullptr;
+        busy_workers_ = workers_.size();
+        ++generation_;
+    }
+    work_ready_.notify_all();
+    DrainTasks();
+
+    std::unique_lock lock(mutex_);
+    work_done_.wait(lock, [this] { return busy_workers_ == 0; });
+    job_ = nullptr;
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+[[nodiscard]] inline ParallelExecutor& ParallelExecutor::Default() {
+    static ParallelExecutor executor;
+    return executor;
+}
+
+inline void ParallelExecutor::WorkerLoop() {
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            work_ready_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+        DrainTasks();
+        {
+            std::lock_guard guard(mutex_);
+            --busy_workers_;
+        }
+        work_done_.notify_one();
+    }
+}
+
+// Разбирает задачи текущего пакета, пока они не закончатся
+inline void ParallelExecutor::DrainTasks() noexcept {
+    for (size_t i = next_task_.fetch_add(1); i < job_size_; i = next_task_.fetch_add(1)) {
+        try {
+            job_(i);
+        } catch (...) {
+            std::lock_guard guard(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+}
+
+namespace parallel_detail {
+
+// Шаг индекса по умолчанию: несколько кусков на поток, чтобы сгладить неравномерность работы
+[[nodiscard]] inline size_t DefaultStride(size_t size, const ParallelExecutor& executor) noexcept {
+    const size_t chunks = executor.GetThreadCount() * 4;
+    return std::max<size_t>(1, (size + chunks - 1) / chunks);
+}
+
+template <typename TList>
+[[nodiscard]] auto BuildIndex(TList& list, const ParallelExecutor& executor) {
+    return SplitIndex<decltype(list.begin())>(list.begin(), list.end(),
+                                              DefaultStride(list.GetSize(), executor));
+}
+
+} // namespace parallel_detail
+
+// Применяет f к каждому элементу, разбивая обход по готовому индексу.
+// Порядок вызовов f между кусками не определён
+template <typename It, typename F>
+void ParallelForEach(const SplitIndex<It>& index, F f, ParallelExecutor& executor = ParallelExecutor::Default()) {
+    executor.Run(index.GetChunkCount(), [&](size_t chunk) {
+        std::for_each(index.ChunkBegin(chunk), index.ChunkEnd(chunk), f);
+    });
+}
+
+// Применяет f к каждому элементу списка. Индекс разбиения строится за один последовательный проход
+template <typename Type, typename F>
+void ParallelForEach(SingleLinkedList<Type>& list, F f, ParallelExecutor& executor = ParallelExecutor::Default()) {
+    ParallelForEach(parallel_detail::BuildIndex(list, executor), std::move(f), executor);
+}
+
+template <typename Type, typename F>
+void ParallelForEach(const SingleLinkedList<Type>& list, F f,
+                     ParallelExecutor& executor = ParallelExecutor::Default()) {
+    ParallelForEach(parallel_detail::BuildIndex(list, executor), std::move(f), executor);
+}
+
+// Сворачивает элементы ассоциативной операцией op, начиная с init.
+// Каждый кусок сворачивается независимо, начиная со своего первого элемента, затем частичные результаты
+// объединяются по порядку, поэтому коммутативность op не нужна. Требования - как у std::reduce:
+// T перемещаем (конструктором и присваиванием), элемент приводится к T, а op(T, элемент) и op(T, T)
+// возвращают значения, приводимые к T. Конструктор по умолчанию у T не нужен
+template <typename It, typename T, typename BinaryOp>
+[[nodiscard]] T ParallelReduce(const SplitIndex<It>& index, T init, BinaryOp op,
+                               ParallelExecutor& executor = ParallelExecutor::Default()) {
+    std::vector<std::optional<T>> partial(index.GetChunkCount());
+    executor.Run(index.GetChunkCount(), [&](size_t chunk) {
+        auto first = index.ChunkBegin(chunk);
+        const auto last = index.ChunkEnd(chunk);
+        T acc = *first;
+        for (++first; first != last; ++first) {
+            acc = op(std::move(acc), *first);
+        }
+        partial[chunk].emplace(std::move(acc));
+    });
+    for (std::optional<T>& value : partial) {
+        init = op(std::move(init), std::move(*value));
+    }
+    return init;
+}
+
+template <typename Type, typename T, typename BinaryOp>
+[[nodiscard]] T ParallelReduce(const SingleLinkedList<Type>& list, T init, BinaryOp op,
+                               ParallelExecutor& executor = ParallelExecutor::Default()) {
+    return ParallelReduce(parallel_detail::BuildIndex(list, executor), std::move(init), std::move(op), executor);
+}
+
+// Подсчитывает элементы, удовлетворяющие предикату pred
+template <typename It, typename Predicate>
+[[nodiscard]] size_t ParallelCount(const SplitIndex<It>& index, Predicate pred,
+                                   ParallelExecutor& executor = ParallelExecutor::Default()) {
+    std::vector<size_t> partial(index.GetChunkCount());
+    executor.Run(index.GetChunkCount(), [&](size_t chunk) {
+        partial[chunk] = static_cast<size_t>(std::count_if(index.ChunkBegin(chunk), index.ChunkEnd(chunk), pred));
+    });
+    size_t count = 0;
+    for (size_t value : partial) {
+        count += value;
+    }
+    return count;
+}
+
+template <typename Type, typename Predicate>
+[[nodiscard]] size_t ParallelCount(const SingleLinkedList<Type>& list, Predicate pred,
+                                   ParallelExecutor& executor = ParallelExecutor::Default()) {
+    return ParallelCount(parallel_detail::BuildIndex(list, executor), std::move(pred), executor);
+}
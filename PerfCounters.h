@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Аппаратные счётчики производительности текущего потока (Linux, perf_event_open).
+// Каждый счётчик открывается отдельно: если часть событий недоступна (виртуальная машина,
+// ограничения perf_event_paranoid, другая ОС), остальные продолжают работать.
+// Если не удалось открыть ни одного, IsAvailable() возвращает false, а Stop() - пустой набор
+class PerfCounters {
+public:
+    using Values = std::vector<std::pair<std::string, double>>;
+
+    PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    ~PerfCounters();
+
+    [[nodiscard]] bool IsAvailable() const noexcept {return !counters_.empty();}
+    // Почему недоступны счётчики (пусто, если открыты все)
+    [[nodiscard]] const std::string& GetDiagnostics() const noexcept {return diagnostics_;}
+
+    void Start() noexcept;      // Обнуляет и запускает счётчики
+    [[nodiscard]] Values Stop() noexcept;   // Останавливает счётчики и возвращает их значения
+
+private:
+    struct Counter {
+        std::string name;
+        int fd = -1;
+    };
+
+    std::vector<Counter> counters_;
+    std::string diagnostics_;
+};
+
+#ifdef __linux__
+
+inline PerfCounters::PerfCounters() {
+    struct Event {
+        const char* name;
+        std::uint32_t type;
+        std::uint64_t config;
+    };
+    // Кэш-события кодируются как id | (операция << 8) | (результат << 16)
+    constexpr auto cache_read_miss = [](std::uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    const Event events[] = {
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"l1d_misses", PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_L1D)},
+        {"llc_misses", PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL)},
+        {"dtlb_misses", PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_DTLB)},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    for (const Event& event : events) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // Время работы счётчика позволяет поправить значения при мультиплексировании
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) {
+            diagnostics_ += std::string(diagnostics_.empty() ? "" : "; ") + event.name + ": "
+                + std::strerror(errno);
+            continue;
+        }
+        counters_.push_back({event.name, static_cast<int>(fd)});
+    }
+}
+
+inline PerfCounters::~PerfCounters() {
+    for (const Counter& counter : counters_) {
+        close(counter.fd);
+    }
+}
+
+inline void PerfCounters::Start() noexcept {
+    for (const Counter& counter : counters_) {
+        ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+[[nodiscard]] inline PerfCounters::Values PerfCounters::Stop() noexcept {
+    for (const Counter& counter : counters_) {
+        ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    Values values;
+    for (const Counter& counter : counters_) {
+        // value, time_enabled, time_running
+        std::uint64_t data[3] = {0, 0, 0};
+        if (read(counter.fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+            continue;
+        }
+        const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        values.emplace_back(counter.name, static_cast<double>(data[0]) * scale);
+    }
+    return values;
+}
+
+#else
+
+inline PerfCounters::PerfCounters()
+    : diagnostics_("hardware counters are supported only on Linux") {
+}
+
+inline PerfCounters::~PerfCounters() = default;
+
+inline void PerfCounters::Start() noexcept {
+}
+
+[[nodiscard]] inline PerfCounters::Values PerfCounters::Stop() noexcept {
+    return {};
+}
+
+#endif
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+namespace persistent_detail {
+
+// Неизменяемый узел с атомарным счётчиком ссылок. Узел принадлежит всем версиям списков,
+// в которые он входит, и разрушается, когда исчезает последняя ссылка на него
+template <typename Type>
+struct Node {
+    template <typename... Args>
+    explicit Node(const Node* next_node, Args&&... args)
+        : value(std::forward<Args>(args)...)
+        , next(next_node) {
+    }
+
+    Type value;
+    const Node* next = nullptr;
+    mutable std::atomic<size_t> refs{1};
+};
+
+// Новая ссылка на узел
+template <typename Type>
+const Node<Type>* Acquire(const Node<Type>* node) noexcept {
+    if (node != nullptr) {
+        node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+// Снимает ссылку и разрушает цепочку узлов, на которые больше никто не ссылается.
+// Цепочка освобождается циклом, а не рекурсией, чтобы длинный список не переполнил стек
+template <typename Type>
+void Release(const Node<Type>* node) noexcept {
+    while (node != nullptr && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        const Node<Type>* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+// Итератор по неизменяемым узлам. По интерфейсу совпадает с SingleLinkedList<Type>::ConstIterator
+template <typename Type>
+class ConstIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Type*;
+    using reference = const Type&;
+
+    ConstIterator() = default;
+    explicit ConstIterator(const Node<Type>* node) noexcept : node_(node) {}
+
+    [[nodiscard]] bool operator==(const ConstIterator& rhs) const noexcept {return node_ == rhs.node_;}
+    [[nodiscard]] bool operator!=(const ConstIterator& rhs) const noexcept {return node_ != rhs.node_;}
+
+    ConstIterator& operator++() noexcept {
+        assert(node_ != nullptr);
+        node_ = node_->next;
+        return *this;
+    }
+
+    ConstIterator operator++(int) noexcept {
+        auto old_value(*this);
+        ++(*this);
+        return old_value;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {return node_->value;}
+    [[nodiscard]] pointer operator->() const noexcept {return &node_->value;}
+
+    // Узел, на который указывает итератор
+    [[nodiscard]] const Node<Type>* GetNode() const noexcept {return node_;}
+
+private:
+    const Node<Type>* node_ = nullptr;
+};
+
+} // namespace persistent_detail
+
+// Неизменяемый односвязный список. Каждая операция, меняющая содержимое, возвращает новую версию,
+// а исходная остаётся прежней. Версии делят общие хвосты: PushFront и PopFront работают за O(1),
+// копирование (снимок) - тоже O(1) и не копирует элементы.
+// Разные версии можно читать и освобождать из разных потоков без блокировок
+template <typename Type>
+class PersistentSingleLinkedList {
+    using Node = persistent_detail::Node<Type>;
+
+public:
+    using ConstIterator = persistent_detail::ConstIterator<Type>;
+
+    using value_type = Type;
+    using reference = const Type&;
+    using const_reference = const Type&;
+    using iterator = ConstIterator;
+    using const_iterator = ConstIterator;
+
+    PersistentSingleLinkedList() = default;
+    PersistentSingleLinkedList(std::initializer_list<Type> values);
+    template <typename InputIt>
+    PersistentSingleLinkedList(InputIt first, InputIt last);        // Копирует элементы диапазона
+    PersistentSingleLinkedList(const PersistentSingleLinkedList& other) noexcept;   // Снимок за O(1)
+    PersistentSingleLinkedList(PersistentSingleLinkedList&& other) noexcept;
+    ~PersistentSingleLinkedList();
+
+    PersistentSingleLinkedList& operator=(const PersistentSingleLinkedList& rhs) noexcept;
+    PersistentSingleLinkedList& operator=(PersistentSingleLinkedList&& rhs) noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] bool IsEmpty() const noexcept {return size_ == 0;}
+
+    // Первый элемент. Список не должен быть пустым
+    [[nodiscard]] const Type& Front() const noexcept {
+        assert(head_ != nullptr);
+        return head_->value;
+    }
+
+    // Новые версии списка; исходный список не меняется
+    [[nodiscard]] PersistentSingleLinkedList PushFront(const Type& value) const;
+    [[nodiscard]] PersistentSingleLinkedList PushFront(Type&& value) const;
+    [[nodiscard]] PersistentSingleLinkedList PopFront() const noexcept;
+
+    // Делят ли два списка узлы (например, один получен из другого через PushFront/PopFront)
+    [[nodiscard]] bool SharesTailWith(const PersistentSingleLinkedList& other) const noexcept;
+
+    void swap(PersistentSingleLinkedList& other) noexcept;
+
+    [[nodiscard]] ConstIterator begin() const noexcept {return ConstIterator(head_);}
+    [[nodiscard]] ConstIterator end() const noexcept {return ConstIterator(nullptr);}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+
+private:
+    const Node* head_ = nullptr;
+    size_t size_ = 0;
+
+    // Принимает уже учтённую ссылку на head
+    PersistentSingleLinkedList(const Node* head, size_t size) noexcept : head_(head), size_(size) {}
+};
+
+template <typename Type>
+PersistentSingleLinkedList<Type>::PersistentSingleLinkedList(std::initializer_list<Type> values)
+    : PersistentSingleLinkedList(values.begin(), values.end()) {
+}
+
+// Узлы создаются в порядке элементов диапазона и присоединяются к хвосту.
+// Если копирование элемента выбросит исключение, уже созданные узлы освобождаются
+template <typename Type>
+template <typename InputIt>
+PersistentSingleLinkedList<Type>::PersistentSingleLinkedList(InputIt first, InputIt last) {
+    PersistentSingleLinkedList tmp;
+    const Node** tail = &tmp.head_;
+    for (; first != last; ++first) {
+        Node* node = new Node(nullptr, *first);
+        *tail = node;
+        tail = &node->next;
+        ++tmp.size_;
+    }
+    swap(tmp);
+}
+
+template <typename Type>
+PersistentSingleLinkedList<Type>::PersistentSingleLinkedList(const PersistentSingleLinkedList& other) noexcept
+    : head_(persistent_detail::Acquire(other.head_))
+    , size_(other.size_) {
+}
+
+template <typename Type>
+PersistentSingleLinkedList<Type>::PersistentSingleLinkedList(PersistentSingleLinkedList&& other) noexcept {
+    swap(other);
+}
+
+template <typename Type>
+PersistentSingleLinkedList<Type>::~PersistentSingleLinkedList() {
+    persistent_detail::Release(head_);
+}
+
+template <typename Type>
+PersistentSingleLinkedList<Type>& PersistentSingleLinkedList<Type>::operator=(
+        const PersistentSingleLinkedList& rhs) noexcept {
+    PersistentSingleLinkedList tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename Type>
+PersistentSingleLinkedList<Type>& PersistentSingleLinkedList<Type>::operator=(
+        PersistentSingleLinkedList&& rhs) noexcept {
+    if (this != &rhs) {
+        PersistentSingleLinkedList tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+// Новый узел ссылается на текущую голову, которая теперь принадлежит и новой версии
+template <typename Type>
+[[nodiscard]] PersistentSingleLinkedList<Type> PersistentSingleLinkedList<Type>::PushFront(const Type& value) const {
+    const Node* node = new Node(head_, value);
+    persistent_detail::Acquire(head_);
+    return PersistentSingleLinkedList(node, size_ + 1);
+}
+
+template <typename Type>
+[[nodiscard]] PersistentSingleLinkedList<Type> PersistentSingleLinkedList<Type>::PushFront(Type&& value) const {
+    const Node* node = new Node(head_, std::move(value));
+    persistent_detail::Acquire(head_);
+    return PersistentSingleLinkedList(node, size_ + 1);
+}
+
+// Версия без первого элемента - это просто ещё одна ссылка на второй узел
+template <typename Type>
+[[nodiscard]] PersistentSingleLinkedList<Type> PersistentSingleLinkedList<Type>::PopFront() const noexcept {
+    assert(head_ != nullptr);
+    return PersistentSingleLinkedList(persistent_detail::Acquire(head_->next), size_ - 1);
+}
+
+// Общие узлы образуют общий хвост: достаточно сравнить узлы на одинаковом расстоянии от конца
+template <typename Type>
+[[nodiscard]] bool PersistentSingleLinkedList<Type>::SharesTailWith(
+        const PersistentSingleLinkedList& other) const noexcept {
+    const Node* lhs = head_;
+    const Node* rhs = other.head_;
+    for (size_t i = size_; i > other.size_; --i) {
+        lhs = lhs->next;
+    }
+    for (size_t i = other.size_; i > size_; --i) {
+        rhs = rhs->next;
+    }
+    // Цепочки одинаковой длины: первый общий узел находится на одной и той же позиции
+    for (; lhs != nullptr; lhs = lhs->next, rhs = rhs->next) {
+        if (lhs == rhs) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Type>
+void PersistentSingleLinkedList<Type>::swap(PersistentSingleLinkedList& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+}
+
+template <typename Type>
+void swap(PersistentSingleLinkedList<Type>& lhs, PersistentSingleLinkedList<Type>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+// Версии, делящие голову, равны без обхода элементов
+template <typename Type>
+bool operator==(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    for (auto l = lhs.begin(), r = rhs.begin(); l != lhs.end(); ++l, ++r) {
+        if (l.GetNode() == r.GetNode()) {
+            return true;
+        }
+        if (!(*l == *r)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type>
+bool operator!=(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SingleLinkedList.h"
+
+// Подсказка процессору заранее загрузить в кэш память по адресу addr (только чтение, высокая локальность).
+// На компиляторах без __builtin_prefetch ничего не делает
+#if defined(__GNUC__) || defined(__clang__)
+#define SINGLE_LINKED_LIST_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define SINGLE_LINKED_LIST_PREFETCH(addr) ((void)(addr))
+#endif
+
+// Адаптер итератора, который при каждом шаге запрашивает предвыборку узла,
+// находящегося на distance элементов впереди текущей позиции.
+// Опережающий курсор сам проходит по цепочке, поэтому к моменту, когда до узла
+// дойдёт основной обход, его загрузка из памяти уже в пути
+template <typename It>
+class PrefetchingIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using difference_type = typename std::iterator_traits<It>::difference_type;
+    using pointer = typename std::iterator_traits<It>::pointer;
+    using reference = typename std::iterator_traits<It>::reference;
+
+    PrefetchingIterator() = default;
+
+    // Итератор на first с опережением distance; last ограничивает опережающий курсор
+    PrefetchingIterator(It first, It last, size_t distance)
+        : current_(first)
+        , ahead_(first)
+        , last_(last) {
+        for (size_t i = 0; i < distance && ahead_ != last_; ++i) {
+            ++ahead_;
+            Prefetch();
+        }
+    }
+
+    // Итератор-ограничитель для конца диапазона
+    explicit PrefetchingIterator(It last)
+        : current_(last)
+        , ahead_(last)
+        , last_(last) {
+    }
+
+    [[nodiscard]] bool operator==(const PrefetchingIterator& rhs) const noexcept {
+        return current_ == rhs.current_;
+    }
+
+    [[nodiscard]] bool operator!=(const PrefetchingIterator& rhs) const noexcept {
+        return current_ != rhs.current_;
+    }
+
+    PrefetchingIterator& operator++() noexcept {
+        ++current_;
+        if (ahead_ != last_) {
+            ++ahead_;
+            Prefetch();
+        }
+        return *this;
+    }
+
+    PrefetchingIterator operator++(int) noexcept {
+        auto old_value(*this);
+        ++(*this);
+        return old_value;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+        return *current_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+        return current_.operator->();
+    }
+
+    // Исходный итератор на текущую позицию
+    [[nodiscard]] It base() const noexcept {
+        return current_;
+    }
+
+private:
+    It current_ = {};
+    It ahead_ = {};
+    It last_ = {};
+
+    // Значение хранится в начале узла, так что предвыборка по его адресу захватывает и next_node
+    // для небольших Type
+    void Prefetch() const noexcept {
+        if (ahead_ != last_) {
+            SINGLE_LINKED_LIST_PREFETCH(std::addressof(*ahead_));
+        }
+    }
+};
+
+// Опережение по умолчанию: достаточно, чтобы перекрыть задержку памяти работой над текущими узлами
+inline constexpr size_t kDefaultPrefetchDistance = 8;
+
+// Диапазон [first, last) в виде пары предвыбирающих итераторов
+template <typename It>
+[[nodiscard]] std::pair<PrefetchingIterator<It>, PrefetchingIterator<It>>
+MakePrefetchingRange(It first, It last, size_t distance = kDefaultPrefetchDistance) {
+    return {PrefetchingIterator<It>(first, last, distance), PrefetchingIterator<It>(last)};
+}
+
+// Применяет f ко всем элементам диапазона, запрашивая предвыборку узлов на distance шагов вперёд
+template <typename It, typename F>
+F ForEachPrefetched(It first, It last, F f, size_t distance = kDefaultPrefetchDistance) {
+    for (PrefetchingIterator<It> it(first, last, distance), end(last); it != end; ++it) {
+        f(*it);
+    }
+    return f;
+}
+
+// Применяет f ко всем элементам списка с предвыборкой узлов на distance шагов вперёд
+template <typename Type, typename F>
+F ForEachPrefetched(SingleLinkedList<Type>& list, F f, size_t distance = kDefaultPrefetchDistance) {
+    return ForEachPrefetched(list.begin(), list.end(), std::move(f), distance);
+}
+
+template <typename Type, typename F>
+F ForEachPrefetched(const SingleLinkedList<Type>& list, F f, size_t distance = kDefaultPrefetchDistance) {
+    return ForEachPrefetched(list.begin(), list.end(), std::move(f), distance);
+}
+
+// Количество списков, по которым поиск в FindInEach идёт одновременно
+inline constexpr size_t kDefaultFindGroupSize = 16;
+
+// Ищет key в каждом из count списков и возвращает итератор на первое вхождение
+// (или end() соответствующего списка) в порядке следования списков.
+// Курсоры group списков продвигаются по очереди: пока ожидается загрузка очередного
+// узла одного списка, процессор успевает запросить узлы других, и промахи кэша перекрываются.
+// group = 0 работает как 1
+template <typename Type>
+[[nodiscard]] std::vector<typename SingleLinkedList<Type>::ConstIterator>
+FindInEach(const SingleLinkedList<Type>* const* lists, size_t count, const Type& key,
+           size_t group = kDefaultFindGroupSize) {
+    using ConstIterator = typename SingleLinkedList<Type>::ConstIterator;
+
+    // Состояние поиска в одном списке
+    struct Cursor {
+        ConstIterator it;
+        ConstIterator end;
+        size_t list_index = 0;
+    };
+
+    group = std::max<size_t>(group, 1);
+    std::vector<ConstIterator> result(count);
+    std::vector<Cursor> cursors;
+    cursors.reserve(group);
+    size_t next_list = 0;
+
+    const auto start = [&](Cursor& cursor) {
+        const SingleLinkedList<Type>& list = *lists[next_list];
+        cursor = Cursor{list.begin(), list.end(), next_list++};
+        if (cursor.it != cursor.end) {
+            SINGLE_LINKED_LIST_PREFETCH(std::addressof(*cursor.it));
+        }
+    };
+
+    while (cursors.size() < group && next_list < count) {
+        start(cursors.emplace_back());
+    }
+
+    while (!cursors.empty()) {
+        for (size_t i = 0; i < cursors.size();) {
+            Cursor& cursor = cursors[i];
+            if (cursor.it != cursor.end && !(*cursor.it == key)) {
+                ++cursor.it;
+                if (cursor.it != cursor.end) {
+                    SINGLE_LINKED_LIST_PREFETCH(std::addressof(*cursor.it));
+                }
+                ++i;
+                continue;
+            }
+            // Поиск в списке завершён: освободившийся курсор берёт следующий список
+            result[cursor.list_index] = cursor.it;
+            if (next_list < count) {
+                start(cursor);
+                ++i;
+            } else {
+                cursor = cursors.back();
+                cursors.pop_back();
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Type>
+[[nodiscard]] std::vector<typename SingleLinkedList<Type>::ConstIterator>
+FindInEach(const std::vector<const SingleLinkedList<Type>*>& lists, const Type& key,
+           size_t group = kDefaultFindGroupSize) {
+    return FindInEach(lists.data(), lists.size(), key, group);
+}
+
+template <typename Type>
+[[nodiscard]] std::vector<typename SingleLinkedList<Type>::ConstIterator>
+FindInEach(const std::vector<SingleLinkedList<Type>*>& lists, const Type& key,
+           size_t group = kDefaultFindGroupSize) {
+    return FindInEach<Type>(lists.data(), lists.size(), key, group);
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+#include "SingleLinkedList.h"
+
+// Размер кэш-линии, по которому выравниваются шарды, чтобы потоки,
+// пишущие в разные шарды, не делили одну линию (false sharing)
+inline constexpr size_t kShardCacheLineSize = 64;
+
+// Список, разбитый на Shards независимых односвязных списков, каждый под своим мьютексом.
+// Предназначен для частых вставок из многих потоков: поток выбирает шард по своему id
+// (или по хэшу переданного ключа) и конкурирует только с потоками того же шарда
+template <typename Type, size_t Shards = 16>
+class ShardedSingleLinkedList {
+    static_assert(Shards > 0, "ShardedSingleLinkedList requires at least one shard");
+
+    // Шард: список, его мьютекс и итератор на последний элемент (нужен для сращивания в Drain)
+    struct alignas(kShardCacheLineSize) Shard {
+        mutable std::mutex mutex;
+        SingleLinkedList<Type> list;
+        typename SingleLinkedList<Type>::ConstIterator last;
+    };
+
+    // Итератор, последовательно обходящий все шарды
+    class MergedIterator;
+
+public:
+    using ConstIterator = MergedIterator;
+
+    ShardedSingleLinkedList() = default;
+    ShardedSingleLinkedList(const ShardedSingleLinkedList&) = delete;
+    ShardedSingleLinkedList& operator=(const ShardedSingleLinkedList&) = delete;
+
+    // Методы класса (потокобезопасные)
+    void PushFront(const Type& value);                      // Вставляет value в шард текущего потока
+    void PushFront(const Type& value, size_t key);          // Вставляет value в шард, выбранный по хэшу key
+    [[nodiscard]] size_t GetSize() const;                   // Суммарное количество элементов во всех шардах
+    [[nodiscard]] bool IsEmpty() const;                     // Сообщает, пусты ли все шарды
+    [[nodiscard]] SingleLinkedList<Type> Drain();           // Забирает элементы всех шардов за время O(Shards)
+    void Clear();                                           // Очищает все шарды
+
+    [[nodiscard]] static constexpr size_t GetShardCount() noexcept {return Shards;}
+
+    // Обход всех шардов. Потоки не должны изменять список во время обхода
+    [[nodiscard]] ConstIterator begin() const noexcept {return ConstIterator(&shards_, 0);}
+    [[nodiscard]] ConstIterator end() const noexcept {return ConstIterator(&shards_, Shards);}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+
+private:
+    std::array<Shard, Shards> shards_;
+
+    [[nodiscard]] static size_t CurrentThreadShard() noexcept;
+    void PushFrontToShard(Shard& shard, const Type& value);
+};
+
+// Вставляет value в шард текущего потока
+template <typename Type, size_t Shards>
+void ShardedSingleLinkedList<Type, Shards>::PushFront(const Type& value) {
+    PushFrontToShard(shards_[CurrentThreadShard()], value);
+}
+
+// Вставляет value в шард, выбранный по хэшу key
+template <typename Type, size_t Shards>
+void ShardedSingleLinkedList<Type, Shards>::PushFront(const Type& value, size_t key) {
+    PushFrontToShard(shards_[std::hash<size_t>{}(key) % Shards], value);
+}
+
+// Суммарное количество элементов во всех шардах.
+// При параллельных вставках результат отражает состояние шардов на момент их опроса
+template <typename Type, size_t Shards>
+[[nodiscard]] size_t ShardedSingleLinkedList<Type, Shards>::GetSize() const {
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+        std::lock_guard guard(shard.mutex);
+        size += shard.list.GetSize();
+    }
+    return size;
+}
+
+// Сообщает, пусты ли все шарды
+template <typename Type, size_t Shards>
+[[nodiscard]] bool ShardedSingleLinkedList<Type, Shards>::IsEmpty() const {
+    for (const Shard& shard : shards_) {
+        std::lock_guard guard(shard.mutex);
+        if (!shard.list.IsEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Забирает элементы всех шардов в один список за время O(Shards).
+// Узлы не копируются: цепочка каждого шарда сращивается с результатом.
+// Порядок элементов совпадает с порядком обхода через begin()/end()
+template <typename Type, size_t Shards>
+[[nodiscard]] SingleLinkedList<Type> ShardedSingleLinkedList<Type, Shards>::Drain() {
+    SingleLinkedList<Type> result;
+    for (size_t i = Shards; i-- > 0;) {
+        Shard& shard = shards_[i];
+        std::lock_guard guard(shard.mutex);
+        result.SpliceAfter(result.cbefore_begin(), shard.list, shard.last);
+        shard.last = {};
+    }
+    return result;
+}
+
+// Очищает все шарды
+template <typename Type, size_t Shards>
+void ShardedSingleLinkedList<Type, Shards>::Clear() {
+    for (Shard& shard : shards_) {
+        SingleLinkedList<Type> tmp;
+        {
+            std::lock_guard guard(shard.mutex);
+            shard.list.swap(tmp);
+            shard.last = {};
+        }
+        // Узлы удаляются вне блокировки
+    }
+}
+
+// Номер шарда текущего потока. Хэш id вычисляется один раз на поток
+template <typename Type, size_t Shards>
+[[nodiscard]] size_t ShardedSingleLinkedList<Type, Shards>::CurrentThreadShard() noexcept {
+    thread_local const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return thread_hash % Shards;
+}
+
+template <typename Type, size_t Shards>
+void ShardedSingleLinkedList<Type, Shards>::PushFrontToShard(Shard& shard, const Type& value) {
+    std::lock_guard guard(shard.mutex);
+    const bool was_empty = shard.list.IsEmpty();
+    shard.list.PushFront(value);
+    // Первый вставленный в пустой шард элемент остаётся последним до его опустошения
+    if (was_empty) {
+        shard.last = shard.list.cbegin();
+    }
+}
+
+template <typename Type, size_t Shards>
+class ShardedSingleLinkedList<Type, Shards>::MergedIterator {
+    friend class ShardedSingleLinkedList<Type, Shards>;
+
+    using InnerIterator = typename SingleLinkedList<Type>::ConstIterator;
+
+    MergedIterator(const std::array<Shard, Shards>* shards, size_t shard_index) noexcept
+        : shards_(shards)
+        , shard_index_(shard_index) {
+        if (shard_index_ < Shards) {
+            it_ = (*shards_)[shard_index_].list.cbegin();
+            SkipEmptyShards();
+        }
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Type*;
+    using reference = const Type&;
+
+    MergedIterator() = default;
+
+    [[nodiscard]] bool operator==(const MergedIterator& rhs) const noexcept {
+        return shard_index_ == rhs.shard_index_ && it_ == rhs.it_;
+    }
+
+    [[nodiscard]] bool operator!=(const MergedIterator& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+    // Переходит к следующему элементу шарда, а по его исчерпании - к следующему непустому шарду
+    MergedIterator& operator++() noexcept {
+        assert(shard_index_ < Shards);
+        ++it_;
+        SkipEmptyShards();
+        return *this;
+    }
+
+    MergedIterator operator++(int) noexcept {
+        auto old_value(*this);
+        ++(*this);
+        return old_value;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+        return *it_;
+    }
+
+    [[nodiscard]] pointer operator->() const noexcept {
+        return it_.operator->();
+    }
+
+private:
+    const std::array<Shard, Shards>* shards_ = nullptr;
+    size_t shard_index_ = Shards;
+    InnerIterator it_;
+
+    void SkipEmptyShards() noexcept {
+        while (it_ == (*shards_)[shard_index_].list.cend()) {
+            if (++shard_index_ == Shards) {
+                it_ = InnerIterator{};
+                return;
+            }
+            it_ = (*shards_)[shard_index_].list.cbegin();
+        }
+    }
+};
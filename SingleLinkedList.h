@@ -1,12 +1,33 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <iterator>
+#include <vector>
 
+#include "NodePool.h"
+#include "SingleLinkedListHash.h"
+#include "SingleLinkedListIndex.h"
+#include "SingleLinkedListInline.h"
+#include "SingleLinkedListMemory.h"
+#include "SingleLinkedListSerialization.h"
+#include "SingleLinkedListStats.h"
+
+// Кэш хэша, индекс позиций и встроенные узлы наследуются, а не хранятся полями: выключенные, они не занимают места
 template <typename Type>
-class SingleLinkedList {
+class SingleLinkedList : private list_hash_detail::HashCache<EnableListHashCache<Type>::value>,
+                         private list_index_detail::PositionIndex<EnableListPositionIndex<Type>::value>,
+                         private list_inline_detail::InlineNodes<Type, ListInlineNodes<Type>::value> {
     // Узел списка
     struct Node;
 
@@ -14,11 +35,28 @@ class SingleLinkedList {
     template <typename ValueType>
     class BasicIterator;
 
+    // Слабы, в которые Compact переносит узлы
+    struct CompactStorage;
+
 public:
+    // Итог уплотнения списка (Compact/CompactStep)
+    struct CompactionResult {
+        size_t nodes_relocated = 0;     // Сколько узлов перенесено в новый слаб
+        size_t bytes_released = 0;      // Сколько байт возвращено распределителю памяти (с учётом служебных данных malloc)
+        size_t bytes_allocated = 0;     // Сколько байт занял новый слаб (0, если узлы легли в хвост прежнего)
+        bool finished = true;           // Пройден ли список до конца
+
+        // Сколько памяти сэкономлено (отрицательное значение - уплотнение потребовало больше памяти)
+        [[nodiscard]] std::ptrdiff_t GetBytesReclaimed() const noexcept {
+            return static_cast<std::ptrdiff_t>(bytes_released) - static_cast<std::ptrdiff_t>(bytes_allocated);
+        }
+    };
+
     // Конструкторы/деструкторы
     SingleLinkedList() = default;                           // Конструктор по умолчанию
     SingleLinkedList(std::initializer_list<Type> values);   // Конструктор на основе initializer_list
     SingleLinkedList(const SingleLinkedList& other);        // Копирующий конструктор
+    SingleLinkedList(SingleLinkedList&& other) noexcept;    // Перемещающий конструктор
     ~SingleLinkedList();                                    // Деструктор
 
     // Методы класса
@@ -27,17 +65,43 @@ public:
     void PushFront(const Type& value);              // Вставляет элемент value в начало списка за время O(1)
     void Clear() noexcept;                          // Очищает список за время O(N)
     void PopFront() noexcept;                       // Удаляет первый элемент списка
-    void swap(SingleLinkedList& other) noexcept;    // Обменивает содержимое списков за время O(1)
+    void swap(SingleLinkedList& other) noexcept;    // Обменивает содержимое списков за время O(1), со встроенными узлами - O(N)
+    CompactionResult Compact();                     // Переносит узлы в непрерывный слаб в порядке обхода за время O(N)
+    CompactionResult CompactStep(size_t max_nodes); // Уплотняет не более max_nodes узлов, продолжая с места прошлого вызова
+    [[nodiscard]] ListMemoryUsage MemoryUsage() const;  // Сколько памяти занимает список и из чего она складывается
+    [[nodiscard]] size_t GetHash() const;           // Хэш содержимого; с кэшем (EnableListHashCache) повторный вызов O(1)
+    void InvalidateHash() noexcept;                 // Сбрасывает кэш хэша после изменения элементов через итераторы
+
+    // Двоичная сериализация (см. ListValueCodec). Прочитанный список лежит в слабах подряд, как после Compact
+    void Serialize(ListByteWriter& writer) const;
+    void Serialize(std::ostream& out) const;
+    [[nodiscard]] static SingleLinkedList Deserialize(ListByteReader& reader);
+    [[nodiscard]] static SingleLinkedList Deserialize(std::istream& in);
+
+    // Статистика выделений памяти всеми списками с элементами Type (см. EnableListStats)
+    [[nodiscard]] static ListStats GetStats() noexcept {return ListStatsRegistry<Type>::Get();}
 
     // Перегрузка операторов
     SingleLinkedList& operator=(const SingleLinkedList& rhs);
+    SingleLinkedList& operator=(SingleLinkedList&& rhs) noexcept;
 
     // Объявление итераторов
     using Iterator = BasicIterator<Type>;
     using ConstIterator = BasicIterator<const Type>;
 
+    // Типы, которые ожидают обобщённые алгоритмы и контейнерные адаптеры
+    using value_type = Type;
+    using reference = Type&;
+    using const_reference = const Type&;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
 
-    [[nodiscard]] Iterator begin() noexcept {return Iterator(head_.next_node);}
+    // Через неконстантные итераторы можно изменить элементы, поэтому они сбрасывают кэш хэша
+    [[nodiscard]] Iterator begin() noexcept {
+        InvalidateHash();
+        return Iterator(head_.next_node);
+    }
     [[nodiscard]] Iterator end() noexcept   {return Iterator{nullptr};}
 
     // Константные версии begin/end для обхода списка без возможности модификации его элементов
@@ -49,7 +113,10 @@ public:
     [[nodiscard]] ConstIterator cend() const noexcept {return ConstIterator{nullptr};}
 
     // Возвращают константный итератор, указывающий на позицию перед первым элементом односвязного списка.
-    [[nodiscard]] Iterator before_begin() noexcept {return Iterator(&head_);}
+    [[nodiscard]] Iterator before_begin() noexcept {
+        InvalidateHash();
+        return Iterator(&head_);
+    }
 
     [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
         Node* temp = const_cast<Node*>(&head_);
@@ -61,28 +128,170 @@ public:
         return ConstIterator(temp);
     }
 
+    // Доступ по номеру элемента. С индексом позиций (EnableListPositionIndex) - не больше kListIndexStride шагов
+    // по списку, пока индекс действителен; без индекса - обход за O(index). Сброшенный индекс перестраивают
+    // только неконстантные версии, константные в этом случае обходят список и ничего в нём не меняют.
+    // Номер за пределами списка - исключение std::out_of_range
+    [[nodiscard]] Type& At(size_t index);
+    [[nodiscard]] const Type& At(size_t index) const;
+
+    // Итератор на элемент с номером index; index == GetSize() даёт end()
+    [[nodiscard]] Iterator IteratorAt(size_t index);
+    [[nodiscard]] ConstIterator IteratorAt(size_t index) const;
+
+    // Итератор на distance элементов дальше it (it - итератор этого списка, в том числе before_begin()).
+    // С индексом позиций дальние переходы занимают O(kListIndexStride * log N) вместо O(distance)
+    [[nodiscard]] Iterator Advance(Iterator it, size_t distance);
+    [[nodiscard]] ConstIterator Advance(ConstIterator it, size_t distance) const;
+
+    // Итератор it на элемент (или before_begin) списка from, содержимое которого перешло в этот список
+    // перемещением или обменом. Элементы из встроенных ячеек from (см. ListInlineNodes) оказываются
+    // в тех же ячейках этого списка, остальные узлы остаются на месте
+    [[nodiscard]] ConstIterator Relocated(ConstIterator it, const SingleLinkedList& from) const noexcept;
+
     // Методы класса с возвратом итератора
-    // Вставка элемента после pos
+    // Вставка элемента после pos. Вставка в начало пересчитывает кэш хэша за O(1), остальные сбрасывают его.
+    // Узел строится без исключений, если их не выбрасывает копирование Type (для тривиальных значений
+    // так всегда), и тогда вставка может выбросить только std::bad_alloc
     Iterator InsertAfter(ConstIterator pos, const Type& value) {
-        Node* insert_node = new Node(value, pos.node_->next_node);
+        if (pos.node_ == &head_) {
+            const std::uint64_t polynomial = PushFrontHash(value);
+            Node* insert_node = CreateNode(value, head_.next_node);
+            head_.next_node = insert_node;
+            ++size_;
+            SetHash(polynomial);
+            PushFrontIndex(insert_node);
+            return Iterator(insert_node);
+        }
+        InvalidateHash();
+        InvalidatePositionIndex();
+        Node* insert_node = CreateNode(value, pos.node_->next_node);
         pos.node_->next_node = insert_node;
         ++size_;
         return Iterator(insert_node);
     }
 
-    // Удаление элемента после pos
+    // Удаление элемента после pos. Удаление первого элемента пересчитывает кэш хэша и индекс позиций за O(1)
     Iterator EraseAfter(ConstIterator pos) noexcept {
         Node* temp = pos.node_->next_node;
+        if (pos.node_ == &head_) {
+            PopFrontHash(temp->value);
+            PopFrontIndex(temp);
+        } else {
+            InvalidateHash();
+            InvalidatePositionIndex();
+        }
         pos.node_->next_node = temp->next_node;
-        delete temp;
+        DestroyNode(temp);
         --size_;
         return Iterator(pos.node_->next_node);
     }
 
+    // Переносит все элементы other после pos за время O(1), не перевыделяя узлы.
+    // other_last должен указывать на последний элемент other. После вызова other пуст.
+    // Узлы из встроенных ячеек other не могут остаться в нём и переносятся в ячейки этого списка или в кучу
+    // за время O(other.GetSize()). Исключение возможно, только если на такой перенос или на присоединение
+    // слабов уплотнённого other не хватило памяти
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other, ConstIterator other_last) {
+        if (other.IsEmpty()) {
+            return;
+        }
+        assert(other_last.node_ != nullptr && other_last.node_->next_node == nullptr);
+        if constexpr (kInlineNodes > 0) {
+            if (other.inline_used_ != 0) {
+                other_last = ConstIterator(MoveInlineNodes(other));
+            }
+        }
+        AdoptCompactStorage(other);
+        InvalidateHash();
+        other.InvalidateHash();
+        InvalidatePositionIndex();
+        other.ClearPositionIndex();
+        other_last.node_->next_node = pos.node_->next_node;
+        pos.node_->next_node = other.head_.next_node;
+        other.head_.next_node = nullptr;
+        size_ += other.size_;
+        other.size_ = 0;
+        other.SetHash(0);
+    }
+
 private:
     // Фиктивный узел, используется для вставки "перед первым элементом"
     Node head_ = {};
     size_t size_ = 0;
+    // Создаётся при первом уплотнении
+    std::unique_ptr<CompactStorage> compact_storage_;
+
+    // Сбор статистики включается на этапе компиляции; при выключенном сборе обращений к счётчикам нет
+    static constexpr bool kCollectStats = EnableListStats<Type>::value;
+    using Stats = ListStatsRegistry<Type>;
+
+    // Кэш хэша тоже включается на этапе компиляции
+    static constexpr bool kCacheHash = EnableListHashCache<Type>::value;
+    using HashCache = list_hash_detail::HashCache<kCacheHash>;
+
+    // И индекс позиций
+    static constexpr bool kPositionIndex = EnableListPositionIndex<Type>::value;
+    using PositionIndex = list_index_detail::PositionIndex<kPositionIndex>;
+
+    // И встроенные узлы. Обмен списков переносит элементы между ячейками и не должен выбрасывать исключений
+    static constexpr size_t kInlineNodes = ListInlineNodes<Type>::value;
+    using InlineNodes = list_inline_detail::InlineNodes<Type, kInlineNodes>;
+    static_assert(kInlineNodes == 0 || std::is_nothrow_move_constructible_v<Type>,
+                  "Inline nodes require a nothrow move constructible element type");
+
+    // Тривиальные значения копируются байтами и освобождаются без деструкторов (см. ListTrivialValues)
+    static constexpr bool kTrivialValues = ListTrivialValues<Type>::value;
+    // Копия из стольких тривиальных значений и больше размещается в одном слабе, а не по узлу в куче
+    static constexpr size_t kMinSlabCopy = NodePool<Node>::kMinSlabCapacity;
+
+    // Первый слаб при чтении списка, длина которого не сверена с размером входа (см. ReadSerializedValues)
+    static constexpr size_t kUnverifiedSlabNodes = NodePool<Node>::kMaxSlabCapacity;
+
+    // Наибольшая длина отрезка, который operator== сравнивает без проверки результата
+    static constexpr size_t kMaxEqualRun = 64;
+
+    template <typename T>
+    friend bool operator==(const SingleLinkedList<T>& lhs, const SingleLinkedList<T>& rhs);
+
+    // Потоковое чтение использует те же функции, что и Deserialize, но читает значения частями
+    template <typename T>
+    friend class ListStreamReader;
+
+    // Хэш-таблица строит цепочки корзин прямо из узлов списка
+    template <typename K, typename V, typename H, typename E>
+    friend class LinkedHashMap;
+
+    [[nodiscard]] static size_t ReadSerializationHeader(ListByteReader& reader);
+    [[nodiscard]] static SingleLinkedList ReadSerializedValues(ListByteReader& reader, size_t count,
+                                                               ConstIterator* last = nullptr);
+
+    [[nodiscard]] bool EqualElements(const SingleLinkedList& other) const;
+    [[nodiscard]] std::uint64_t ComputeHashPolynomial() const;
+    [[nodiscard]] std::uint64_t PushFrontHash(const Type& value) const;
+    void PopFrontHash(const Type& value) noexcept;
+    void SetHash(std::uint64_t polynomial) noexcept;
+    [[nodiscard]] Node* NodeAt(size_t index) const;
+    [[nodiscard]] Node* AdvanceNode(Node* node, size_t distance) const;
+    [[nodiscard]] size_t DistanceToEnd(const Node* node) const;
+    void BuildPositionIndex();
+    void RefreshPositionIndex(bool with_lookup);
+    void PushFrontIndex(Node* node) noexcept;
+    void PopFrontIndex(const Node* node) noexcept;
+    void InvalidatePositionIndex() noexcept;
+    void ClearPositionIndex() noexcept;
+    [[nodiscard]] Node* CreateNode(const Type& value, Node* next);
+    void DestroyNode(Node* node) noexcept;
+    void DropTrivialNodes() noexcept;
+    [[nodiscard]] Node* InlineCell(size_t index) const noexcept;    // Ячейка index, занятая или нет
+    [[nodiscard]] Node* FreeInlineCell() const noexcept;            // Первая свободная ячейка или nullptr
+    [[nodiscard]] std::uint32_t InlineBit(const Node* node) const noexcept;
+    [[nodiscard]] bool IsInline(const Node* node) const noexcept;
+    [[nodiscard]] size_t GetInlineCount() const noexcept;
+    void SwapInlineNodes(SingleLinkedList& other) noexcept;
+    [[nodiscard]] Node* MoveInlineNodes(SingleLinkedList& other);
+    void ReleaseCompactStorage() noexcept;
+    void AdoptCompactStorage(SingleLinkedList& other);
 
     template<typename TList>
     void CopyList(TList& other);
@@ -100,6 +309,14 @@ template <typename Type>
 SingleLinkedList<Type>::SingleLinkedList(const SingleLinkedList& other) {
     assert(size_ == 0 && head_.next_node == nullptr);
     CopyList(other);
+    static_cast<HashCache&>(*this) = other;
+}
+
+// Перемещающий конструктор SingleLinkedList. Узлы other переходят к новому списку.
+// Как и обмен, со встроенными узлами (см. ListInlineNodes) занимает время O(N)
+template <typename Type>
+SingleLinkedList<Type>::SingleLinkedList(SingleLinkedList&& other) noexcept {
+    swap(other);
 }
 
 // Деструктор SingleLinkedList
@@ -123,29 +340,939 @@ template <typename Type>
 // Вставляет элемент value в начало списка за время O(1)
 template <typename Type>
 void SingleLinkedList<Type>::PushFront(const Type& value) {
-    head_.next_node = new Node(value, head_.next_node);
+    const std::uint64_t polynomial = PushFrontHash(value);
+    head_.next_node = CreateNode(value, head_.next_node);
     ++size_;
+    SetHash(polynomial);
+    PushFrontIndex(head_.next_node);
 }
 
-// Очищает список за время O(N)
+// Очищает список за время O(N). Тривиальные значения (см. ListTrivialValues) не разрушаются по одному,
+// а список, все узлы которого лежат в слабах или встроенных ячейках, очищается без обхода
 template <typename Type>
 void SingleLinkedList<Type>::Clear() noexcept {
-    while (head_.next_node != nullptr) {
-        PopFront();
+    if constexpr (kTrivialValues) {
+        DropTrivialNodes();
+    } else {
+        while (head_.next_node != nullptr) {
+            PopFront();
+        }
     }
+    ReleaseCompactStorage();
+    SetHash(0);
+    ClearPositionIndex();
 }
 
 // Удалить первый элемент
 template <typename Type>
 void SingleLinkedList<Type>::PopFront() noexcept {
-    EraseAfter(before_begin());
+    EraseAfter(cbefore_begin());
 }
 
-// Обменивает содержимое списков за время O(1)
+// Обменивает содержимое списков за время O(1). Со встроенными узлами (см. ListInlineNodes) - за время O(N):
+// ссылки на переехавшие ячейки приходится искать обходом списка
 template <typename Type>
 void SingleLinkedList<Type>::swap(SingleLinkedList& other) noexcept {
+    if (this == &other) {
+        return;
+    }
     std::swap(head_.next_node, other.head_.next_node);
     std::swap(size_, other.size_);
+    std::swap(compact_storage_, other.compact_storage_);
+    std::swap(static_cast<HashCache&>(*this), static_cast<HashCache&>(other));
+    std::swap(static_cast<PositionIndex&>(*this), static_cast<PositionIndex&>(other));
+    if constexpr (kInlineNodes > 0) {
+        SwapInlineNodes(other);
+    }
+}
+
+// Переносит узлы в один непрерывный слаб в порядке обхода за время O(N).
+// Значения перемещаются (или копируются, если перемещение может выбросить исключение).
+// Итераторы на элементы списка становятся недействительными
+template <typename Type>
+typename SingleLinkedList<Type>::CompactionResult SingleLinkedList<Type>::Compact() {
+    if (compact_storage_) {
+        compact_storage_->cursor = nullptr;
+    }
+    return CompactStep(size_);
+}
+
+// Уплотняет не более max_nodes узлов, начиная с места, где остановился прошлый вызов.
+// Позволяет растянуть уплотнение большого списка на много коротких шагов: каждый шаг продолжает
+// хвост последнего слаба, а новые слабы растут вдвое, так что слабов остаётся O(log N).
+// Итераторы на перенесённые элементы становятся недействительными
+template <typename Type>
+typename SingleLinkedList<Type>::CompactionResult SingleLinkedList<Type>::CompactStep(size_t max_nodes) {
+    CompactionResult result;
+    if (max_nodes == 0 || IsEmpty()) {
+        return result;
+    }
+    if (!compact_storage_) {
+        compact_storage_ = std::make_unique<CompactStorage>();
+    }
+    NodePool<Node>& pool = compact_storage_->pool;
+    Node* prev = compact_storage_->cursor != nullptr ? compact_storage_->cursor : &head_;
+
+    // Отрезок, который уже лежит в слабе подряд, переносить незачем
+    size_t count = 0;
+    bool sequential = pool.Owns(prev->next_node);
+    for (Node* node = prev->next_node; node != nullptr && count < max_nodes; node = node->next_node, ++count) {
+        sequential = sequential && (node->next_node == nullptr || count + 1 == max_nodes
+                                    || node->next_node == node + 1);
+    }
+
+    if (count > 0 && !sequential) {
+        InvalidatePositionIndex();
+        const size_t slabs = pool.GetSlabCount();
+        const size_t capacity = pool.GetCapacity();
+        Node* slab = pool.AllocateRun(count, size_);
+        if (pool.GetSlabCount() != slabs) {
+            const size_t added = pool.GetCapacity() - capacity;
+            result.bytes_allocated = NodePool<Node>::SlabBytes(added);
+            if constexpr (kCollectStats) {
+                Stats::OnHeapAllocate(added * sizeof(Node));
+            }
+        }
+        size_t i = 0;
+        try {
+            for (; i < count; ++i) {
+                Node* old_node = prev->next_node;
+                Node* new_node = new (slab + i) Node(std::move_if_noexcept(old_node->value), old_node->next_node);
+                prev->next_node = new_node;
+                if constexpr (kCollectStats) {
+                    Stats::OnNodeCreated();
+                    if constexpr (!std::is_nothrow_move_constructible_v<Type>
+                                  && std::is_copy_constructible_v<Type>) {
+                        Stats::OnValueCopied();
+                    }
+                }
+                if (!pool.Owns(old_node) && !IsInline(old_node)) {
+                    result.bytes_released += EstimateMallocChunkSize(sizeof(Node));
+                }
+                DestroyNode(old_node);
+                prev = new_node;
+            }
+        } catch (...) {
+            // Уже перенесённые узлы остаются в слабе, неиспользованные ячейки возвращаются в пул
+            for (; i < count; ++i) {
+                pool.Deallocate(slab + i);
+            }
+            compact_storage_->cursor = nullptr;
+            throw;
+        }
+        result.nodes_relocated = count;
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            prev = prev->next_node;
+        }
+    }
+
+    if constexpr (kCollectStats) {
+        const size_t slabs = pool.GetSlabCount();
+        const size_t capacity = pool.GetCapacity();
+        result.bytes_released += pool.ReleaseEmptySlabs();
+        Stats::OnHeapFree((capacity - pool.GetCapacity()) * sizeof(Node), slabs - pool.GetSlabCount());
+    } else {
+        result.bytes_released += pool.ReleaseEmptySlabs();
+    }
+    result.finished = prev->next_node == nullptr;
+    compact_storage_->cursor = result.finished ? nullptr : prev;
+    return result;
+}
+
+// Сколько памяти занимает список. Без специализации ValueHeapUsage<Type> выполняется за O(1),
+// иначе обходит элементы, чтобы сложить принадлежащую им память
+template <typename Type>
+[[nodiscard]] ListMemoryUsage SingleLinkedList<Type>::MemoryUsage() const {
+    ListMemoryUsage usage;
+    usage.node_count = size_;
+    usage.node_size = sizeof(Node);
+    usage.node_alignment = alignof(Node);
+    usage.node_padding = sizeof(Node) - sizeof(Type) - sizeof(Node*);
+    usage.node_bytes = size_ * sizeof(Node);
+    // Занятые встроенные ячейки уже посчитаны в node_bytes
+    usage.inline_nodes = GetInlineCount();
+    usage.container_bytes = sizeof(SingleLinkedList) - usage.inline_nodes * sizeof(Node);
+
+    if (compact_storage_) {
+        const NodePool<Node>& pool = compact_storage_->pool;
+        usage.pooled_nodes = pool.GetLiveCount();
+        usage.allocator_overhead += pool.GetReservedBytes() - usage.pooled_nodes * sizeof(Node);
+        usage.container_bytes += EstimateMallocChunkSize(sizeof(CompactStorage)) + pool.GetBookkeepingBytes();
+    }
+    if constexpr (kPositionIndex) {
+        usage.container_bytes += this->index_checkpoints_.capacity() * sizeof(void*)
+                                 + this->index_lookup_.capacity() * sizeof(this->index_lookup_[0]);
+    }
+    usage.heap_nodes = size_ - usage.pooled_nodes - usage.inline_nodes;
+    usage.allocator_overhead += usage.heap_nodes * (EstimateMallocChunkSize(sizeof(Node)) - sizeof(Node));
+
+    if constexpr (ValueHeapUsage<Type>::kOwnsHeapMemory) {
+        for (const Type& value : *this) {
+            usage.value_heap_bytes += ValueHeapUsage<Type>::Get(value);
+        }
+    }
+    return usage;
+}
+
+// Записывает заголовок и значения. Побайтовые значения копируются через memcpy прямо в буфер
+// или, при записи в поток, через промежуточный блок, который уходит в поток одним вызовом
+template <typename Type>
+void SingleLinkedList<Type>::Serialize(ListByteWriter& writer) const {
+    using Codec = ListValueCodec<Type>;
+    ListSerializationHeader header;
+    header.value_size = Codec::kBitwise ? static_cast<std::uint32_t>(sizeof(Type)) : 0;
+    header.count = size_;
+    writer.WriteValue(header);
+
+    if constexpr (Codec::kBitwise) {
+        const Node* node = head_.next_node;
+        if (char* out = writer.Reserve(size_ * sizeof(Type))) {
+            for (; node != nullptr; node = node->next_node, out += sizeof(Type)) {
+                std::memcpy(out, &node->value, sizeof(Type));
+            }
+            return;
+        }
+        constexpr size_t kChunkValues = std::max<size_t>(1, (64 << 10) / sizeof(Type));
+        std::vector<char> chunk(std::min(size_, kChunkValues) * sizeof(Type));
+        for (size_t left = size_; left > 0;) {
+            const size_t count = std::min(left, kChunkValues);
+            for (size_t i = 0; i < count; ++i, node = node->next_node) {
+                std::memcpy(chunk.data() + i * sizeof(Type), &node->value, sizeof(Type));
+            }
+            writer.Write(chunk.data(), count * sizeof(Type));
+            left -= count;
+        }
+    } else {
+        for (const Node* node = head_.next_node; node != nullptr; node = node->next_node) {
+            Codec::Encode(node->value, writer);
+        }
+    }
+}
+
+template <typename Type>
+void SingleLinkedList<Type>::Serialize(std::ostream& out) const {
+    ListByteWriter writer(out);
+    Serialize(writer);
+}
+
+// Читает список, записанный Serialize. Узлы размещаются в слабах подряд: в одном, выделенном по длине из заголовка,
+// если её можно сверить с размером входа, иначе в растущих по мере чтения (см. ReadSerializedValues).
+// Повреждённые или неполные данные - исключение std::runtime_error
+template <typename Type>
+[[nodiscard]] SingleLinkedList<Type> SingleLinkedList<Type>::Deserialize(ListByteReader& reader) {
+    const size_t count = ReadSerializationHeader(reader);
+    return ReadSerializedValues(reader, count);
+}
+
+template <typename Type>
+[[nodiscard]] SingleLinkedList<Type> SingleLinkedList<Type>::Deserialize(std::istream& in) {
+    ListByteReader reader(in);
+    return Deserialize(reader);
+}
+
+// Проверяет заголовок и возвращает количество элементов
+template <typename Type>
+[[nodiscard]] size_t SingleLinkedList<Type>::ReadSerializationHeader(ListByteReader& reader) {
+    using Codec = ListValueCodec<Type>;
+    const auto header = reader.ReadValue<ListSerializationHeader>();
+    if (std::memcmp(header.magic, ListSerializationHeader::kMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("SingleLinkedList deserialization: bad header");
+    }
+    if (header.value_size != (Codec::kBitwise ? sizeof(Type) : 0)) {
+        throw std::runtime_error("SingleLinkedList deserialization: value type mismatch");
+    }
+    if (header.count > SIZE_MAX / sizeof(Node)
+        || (Codec::kBitwise && reader.HasKnownSize() && header.count > reader.GetRemaining() / sizeof(Type))) {
+        throw std::runtime_error("SingleLinkedList deserialization: element count exceeds input");
+    }
+    return static_cast<size_t>(header.count);
+}
+
+// Читает count значений в новый список, узлы которого лежат в слабах подряд.
+// Если count уже сверен с размером входа (побайтовые значения из буфера в памяти), слаб один на все узлы.
+// Иначе заголовку верить нельзя: первый слаб вмещает не больше kUnverifiedSlabNodes узлов, а каждый
+// следующий - вдвое больше, по мере того как приходят данные. Так повреждённый count не запросит памяти
+// больше, чем примерно вдвое против действительно прочитанного, а неполные данные приводят
+// к std::runtime_error, а не к std::bad_alloc.
+// В last, если он задан, записывается итератор на последний прочитанный элемент (end() для пустого списка)
+template <typename Type>
+[[nodiscard]] SingleLinkedList<Type> SingleLinkedList<Type>::ReadSerializedValues(ListByteReader& reader, size_t count,
+                                                                                  ConstIterator* last) {
+    using Codec = ListValueCodec<Type>;
+    SingleLinkedList result;
+    if (last != nullptr) {
+        *last = ConstIterator{};
+    }
+    if (count == 0) {
+        return result;
+    }
+    result.compact_storage_ = std::make_unique<CompactStorage>();
+    NodePool<Node>& pool = result.compact_storage_->pool;
+    result.InvalidateHash();
+    result.InvalidatePositionIndex();
+
+    Node* tail = &result.head_;
+    const auto append = [&](Node* node) {
+        tail->next_node = node;
+        tail = node;
+        ++result.size_;
+        if constexpr (kCollectStats) {
+            Stats::OnNodeCreated();
+        }
+    };
+
+    constexpr size_t kChunkValues = std::max<size_t>(1, (64 << 10) / sizeof(Type));
+    std::vector<char> chunk;
+    const bool verified = Codec::kBitwise && reader.HasKnownSize();
+    size_t slab_capacity = verified ? count : std::min(count, kUnverifiedSlabNodes);
+    while (result.size_ < count) {
+        const size_t slab_count = std::min(count - result.size_, slab_capacity);
+        Node* slab = pool.AllocateSlab(slab_count);
+        if constexpr (kCollectStats) {
+            Stats::OnHeapAllocate(slab_count * sizeof(Node));
+        }
+        size_t i = 0;
+        try {
+            if constexpr (Codec::kBitwise) {
+                const auto construct = [&](const char* values, size_t values_count) {
+                    for (size_t end = i + values_count; i < end; ++i, values += sizeof(Type)) {
+                        Node* node = new (slab + i) Node;
+                        std::memcpy(&node->value, values, sizeof(Type));
+                        append(node);
+                    }
+                };
+                if (const char* values = reader.View(slab_count * sizeof(Type))) {
+                    construct(values, slab_count);
+                } else {
+                    chunk.resize(std::min(slab_count, kChunkValues) * sizeof(Type));
+                    while (i < slab_count) {
+                        const size_t values_count = std::min(slab_count - i, kChunkValues);
+                        reader.Read(chunk.data(), values_count * sizeof(Type));
+                        construct(chunk.data(), values_count);
+                    }
+                }
+            } else {
+                for (; i < slab_count; ++i) {
+                    append(new (slab + i) Node(Codec::Decode(reader), nullptr));
+                }
+            }
+        } catch (...) {
+            // Прочитанные узлы разрушит деструктор result, непрочитанные ячейки возвращаются в пул
+            for (; i < slab_count; ++i) {
+                pool.Deallocate(slab + i);
+            }
+            throw;
+        }
+        slab_capacity = std::min(slab_capacity, SIZE_MAX / 2) * 2;
+    }
+    if (last != nullptr) {
+        *last = ConstIterator(tail);
+    }
+    return result;
+}
+
+// Поэлементно сравнивает со списком той же длины.
+// Пока узлы обоих списков лежат в памяти подряд (например, после Compact), адрес следующего узла
+// известен заранее и процессор загружает узлы, не дожидаясь чтения next_node
+template <typename Type>
+[[nodiscard]] bool SingleLinkedList<Type>::EqualElements(const SingleLinkedList& other) const {
+    assert(size_ == other.size_);
+    const Node* lhs = head_.next_node;
+    const Node* rhs = other.head_.next_node;
+    while (lhs != nullptr) {
+        // Длина отрезка, который в обоих списках лежит подряд
+        const Node* lhs_last = lhs;
+        const Node* rhs_last = rhs;
+        size_t run = 1;
+        while (run < kMaxEqualRun && lhs_last->next_node == lhs_last + 1 && rhs_last->next_node == rhs_last + 1) {
+            ++lhs_last;
+            ++rhs_last;
+            ++run;
+        }
+
+        if constexpr (IsBitwiseComparable<Type>::value) {
+            bool differs = false;
+            for (size_t i = 0; i < run; ++i) {
+                differs |= lhs[i].value != rhs[i].value;
+            }
+            if (differs) {
+                return false;
+            }
+        } else {
+            for (size_t i = 0; i < run; ++i) {
+                if (!(lhs[i].value == rhs[i].value)) {
+                    return false;
+                }
+            }
+        }
+        lhs = lhs_last->next_node;
+        rhs = rhs_last->next_node;
+    }
+    return true;
+}
+
+// Хэш содержимого списка. Без кэша вычисляется за O(N); с кэшем - один раз после изменения,
+// которое нельзя учесть за O(1). Кэш не синхронизирован: одновременный вызов GetHash
+// для одного списка из нескольких потоков требует внешней блокировки
+template <typename Type>
+[[nodiscard]] size_t SingleLinkedList<Type>::GetHash() const {
+    if constexpr (kCacheHash) {
+        if (!this->hash_valid_) {
+            this->hash_polynomial_ = ComputeHashPolynomial();
+            this->hash_valid_ = true;
+        }
+        return list_hash_detail::Finalize(this->hash_polynomial_, size_);
+    } else {
+        return list_hash_detail::Finalize(ComputeHashPolynomial(), size_);
+    }
+}
+
+// Изменения элементов через ранее полученные итераторы кэш не отслеживает:
+// после них хэш нужно сбросить явно
+template <typename Type>
+void SingleLinkedList<Type>::InvalidateHash() noexcept {
+    if constexpr (kCacheHash) {
+        this->hash_valid_ = false;
+    }
+}
+
+// Многочлен хэша за один проход. Степени основания для соседних элементов считаются в четырёх
+// независимых цепочках умножений, а на отрезках подряд лежащих узлов адрес следующего узла известен заранее
+template <typename Type>
+[[nodiscard]] std::uint64_t SingleLinkedList<Type>::ComputeHashPolynomial() const {
+    using list_hash_detail::kBase;
+    constexpr std::uint64_t kBase4 = kBase * kBase * kBase * kBase;
+    std::uint64_t lanes[4] = {0, 0, 0, 0};
+    std::uint64_t powers[4] = {1, kBase, kBase * kBase, kBase * kBase * kBase};
+    size_t lane = 0;
+    for (const Node* node = head_.next_node; node != nullptr;) {
+        const Node* last = node;
+        size_t run = 1;
+        while (last->next_node == last + 1) {
+            ++last;
+            ++run;
+        }
+        for (size_t i = 0; i < run; ++i) {
+            lanes[lane] += list_hash_detail::HashValue(node[i].value) * powers[lane];
+            if (++lane == 4) {
+                lane = 0;
+                for (std::uint64_t& power : powers) {
+                    power *= kBase4;
+                }
+            }
+        }
+        node = last->next_node;
+    }
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Многочлен после вставки value в начало: h(value) + P * H. Вычисляется до изменения списка,
+// чтобы исключение из std::hash не оставило список изменённым
+template <typename Type>
+[[nodiscard]] std::uint64_t SingleLinkedList<Type>::PushFrontHash(const Type& value) const {
+    if constexpr (kCacheHash) {
+        if (this->hash_valid_) {
+            return list_hash_detail::HashValue(value) + list_hash_detail::kBase * this->hash_polynomial_;
+        }
+    }
+    (void)value;
+    return 0;
+}
+
+// Многочлен после удаления первого элемента value: (H - h(value)) / P
+template <typename Type>
+void SingleLinkedList<Type>::PopFrontHash(const Type& value) noexcept {
+    if constexpr (kCacheHash) {
+        if constexpr (list_hash_detail::kNothrowHash<Type>) {
+            if (this->hash_valid_) {
+                this->hash_polynomial_ = (this->hash_polynomial_ - list_hash_detail::HashValue(value))
+                    * list_hash_detail::kBaseInverse;
+            }
+        } else {
+            this->hash_valid_ = false;
+        }
+    }
+    (void)value;
+}
+
+// Записывает в кэш многочлен, если кэш действителен (или список пуст)
+template <typename Type>
+void SingleLinkedList<Type>::SetHash(std::uint64_t polynomial) noexcept {
+    if constexpr (kCacheHash) {
+        if (this->hash_valid_ || size_ == 0) {
+            this->hash_polynomial_ = polynomial;
+            this->hash_valid_ = true;
+        }
+    }
+    (void)polynomial;
+}
+
+// Элемент с номером index. Проверка границ - как у std::vector::at
+template <typename Type>
+[[nodiscard]] Type& SingleLinkedList<Type>::At(size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("SingleLinkedList::At: index out of range");
+    }
+    InvalidateHash();
+    RefreshPositionIndex(false);
+    return NodeAt(index)->value;
+}
+
+template <typename Type>
+[[nodiscard]] const Type& SingleLinkedList<Type>::At(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("SingleLinkedList::At: index out of range");
+    }
+    return NodeAt(index)->value;
+}
+
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Iterator SingleLinkedList<Type>::IteratorAt(size_t index) {
+    assert(index <= size_);
+    InvalidateHash();
+    RefreshPositionIndex(false);
+    return Iterator(NodeAt(index));
+}
+
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::ConstIterator SingleLinkedList<Type>::IteratorAt(size_t index) const {
+    assert(index <= size_);
+    return ConstIterator(NodeAt(index));
+}
+
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Iterator SingleLinkedList<Type>::Advance(Iterator it, size_t distance) {
+    RefreshPositionIndex(it.node_ != &head_ && distance > kListIndexStride);
+    return Iterator(AdvanceNode(it.node_, distance));
+}
+
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::ConstIterator SingleLinkedList<Type>::Advance(ConstIterator it,
+                                                                                           size_t distance) const {
+    return ConstIterator(AdvanceNode(it.node_, distance));
+}
+
+// Без встроенных узлов перемещение и обмен не двигают узлы, и итератор остаётся прежним
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::ConstIterator SingleLinkedList<Type>::Relocated(
+        ConstIterator it, const SingleLinkedList& from) const noexcept {
+    if (it.node_ == &from.head_) {
+        return cbefore_begin();
+    }
+    if constexpr (kInlineNodes > 0) {
+        if (from.IsInline(it.node_)) {
+            return ConstIterator(InlineCell(static_cast<size_t>(it.node_ - from.InlineCell(0))));
+        }
+    }
+    return it;
+}
+
+// Узел с номером index (nullptr для index == size_). С действительным индексом поиск начинается с ближайшей
+// контрольной точки перед узлом: до неё не больше kListIndexStride шагов. Индекс не перестраивается
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Node* SingleLinkedList<Type>::NodeAt(size_t index) const {
+    if (index >= size_) {
+        return nullptr;
+    }
+    Node* node = head_.next_node;
+    size_t steps = index;
+    if constexpr (kPositionIndex) {
+        const size_t to_end = size_ - 1 - index;
+        const size_t checkpoint = (to_end + kListIndexStride - 1) / kListIndexStride;
+        if (this->index_valid_ && checkpoint < this->index_checkpoints_.size()) {
+            node = static_cast<Node*>(this->index_checkpoints_[checkpoint]);
+            steps = checkpoint * kListIndexStride - to_end;
+        }
+    }
+    for (; steps > 0; --steps) {
+        node = node->next_node;
+    }
+    return node;
+}
+
+// Узел на distance шагов дальше node. С действительным индексом и упорядоченными по адресу точками
+// дальний переход сводится к NodeAt: номер node определяется по ближайшей следующей контрольной точке
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Node* SingleLinkedList<Type>::AdvanceNode(Node* node,
+                                                                                       size_t distance) const {
+    if (distance == 0) {
+        return node;
+    }
+    if (node == &head_) {
+        assert(distance <= size_ + 1);
+        return distance > size_ ? nullptr : NodeAt(distance - 1);
+    }
+    if constexpr (kPositionIndex) {
+        if (distance > kListIndexStride && this->index_valid_ && this->index_lookup_valid_) {
+            const size_t to_end = DistanceToEnd(node);
+            assert(distance <= to_end + 1);
+            return distance > to_end ? nullptr : NodeAt(size_ - 1 - (to_end - distance));
+        }
+    }
+    for (; distance > 0; --distance) {
+        assert(node != nullptr);
+        node = node->next_node;
+    }
+    return node;
+}
+
+// Сколько узлов в списке после node. Последний узел - всегда контрольная точка,
+// поэтому до точки не больше kListIndexStride шагов, и на каждом - двоичный поиск по адресу
+template <typename Type>
+[[nodiscard]] size_t SingleLinkedList<Type>::DistanceToEnd(const Node* node) const {
+    assert(this->index_valid_ && this->index_lookup_valid_);
+    const auto& lookup = this->index_lookup_;
+    for (size_t steps = 0;; ++steps, node = node->next_node) {
+        assert(node != nullptr && "node must belong to this list");
+        const auto it = std::lower_bound(lookup.begin(), lookup.end(), static_cast<const void*>(node),
+                                         [](const auto& entry, const void* key) {
+                                             return std::less<const void*>{}(entry.first, key);
+                                         });
+        if (it != lookup.end() && it->first == node) {
+            return it->second * kListIndexStride + steps;
+        }
+    }
+}
+
+// Строит контрольные точки за один проход по списку
+template <typename Type>
+void SingleLinkedList<Type>::BuildPositionIndex() {
+    if constexpr (kPositionIndex) {
+        auto& checkpoints = this->index_checkpoints_;
+        checkpoints.assign(size_ == 0 ? 0 : (size_ - 1) / kListIndexStride + 1, nullptr);
+        size_t to_end = size_;
+        for (Node* node = head_.next_node; node != nullptr; node = node->next_node) {
+            if (--to_end % kListIndexStride == 0) {
+                checkpoints[to_end / kListIndexStride] = node;
+            }
+        }
+        this->index_valid_ = true;
+        this->index_lookup_valid_ = false;
+    }
+}
+
+// Перестраивает сброшенный индекс, а если нужен with_lookup, то и точки, упорядоченные по адресу.
+// Вызывается только из неконстантных методов: константные читают индекс, но не меняют его
+template <typename Type>
+void SingleLinkedList<Type>::RefreshPositionIndex(bool with_lookup) {
+    if constexpr (kPositionIndex) {
+        if (!this->index_valid_) {
+            BuildPositionIndex();
+        }
+        if (with_lookup && !this->index_lookup_valid_) {
+            auto& lookup = this->index_lookup_;
+            const auto& checkpoints = this->index_checkpoints_;
+            lookup.resize(checkpoints.size());
+            for (size_t i = 0; i < checkpoints.size(); ++i) {
+                lookup[i] = {checkpoints[i], i};
+            }
+            std::sort(lookup.begin(), lookup.end(), [](const auto& lhs, const auto& rhs) {
+                return std::less<const void*>{}(lhs.first, rhs.first);
+            });
+            this->index_lookup_valid_ = true;
+        }
+    }
+    (void)with_lookup;
+}
+
+// Новый первый узел становится контрольной точкой, если после него кратное kListIndexStride число узлов.
+// Если памяти под точку не хватило, индекс сбрасывается: это лишь ускоряющая структура
+template <typename Type>
+void SingleLinkedList<Type>::PushFrontIndex(Node* node) noexcept {
+    if constexpr (kPositionIndex) {
+        if (this->index_valid_ && (size_ - 1) % kListIndexStride == 0) {
+            try {
+                this->index_checkpoints_.push_back(node);
+                this->index_lookup_valid_ = false;
+            } catch (...) {
+                this->index_valid_ = false;
+            }
+        }
+    }
+    (void)node;
+}
+
+// Удаляемый первый узел - последняя контрольная точка, если после него кратное kListIndexStride число узлов
+template <typename Type>
+void SingleLinkedList<Type>::PopFrontIndex(const Node* node) noexcept {
+    if constexpr (kPositionIndex) {
+        if (this->index_valid_ && (size_ - 1) % kListIndexStride == 0) {
+            assert(this->index_checkpoints_.back() == node);
+            this->index_checkpoints_.pop_back();
+            this->index_lookup_valid_ = false;
+        }
+    }
+    (void)node;
+}
+
+template <typename Type>
+void SingleLinkedList<Type>::InvalidatePositionIndex() noexcept {
+    if constexpr (kPositionIndex) {
+        this->index_valid_ = false;
+    }
+}
+
+// Индекс пустого списка
+template <typename Type>
+void SingleLinkedList<Type>::ClearPositionIndex() noexcept {
+    if constexpr (kPositionIndex) {
+        this->index_checkpoints_.clear();
+        this->index_lookup_.clear();
+        this->index_valid_ = true;
+        this->index_lookup_valid_ = true;
+    }
+}
+
+// Создаёт узел с копией value: в свободной встроенной ячейке, если она есть, иначе в куче
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Node* SingleLinkedList<Type>::CreateNode(const Type& value, Node* next) {
+    if constexpr (kInlineNodes > 0) {
+        if (Node* cell = FreeInlineCell()) {
+            Node* node = new (cell) Node(value, next);
+            this->inline_used_ |= InlineBit(node);
+            if constexpr (kCollectStats) {
+                Stats::OnNodeCreated();
+                Stats::OnValueCopied();
+            }
+            return node;
+        }
+    }
+    Node* node = new Node(value, next);
+    if constexpr (kCollectStats) {
+        Stats::OnHeapAllocate(sizeof(Node));
+        Stats::OnNodeCreated();
+        Stats::OnValueCopied();
+    }
+    return node;
+}
+
+// Разрушает узел и освобождает его память: встроенная ячейка становится свободной,
+// узлы из слабов возвращаются в пул, остальные - в кучу
+template <typename Type>
+void SingleLinkedList<Type>::DestroyNode(Node* node) noexcept {
+    if constexpr (kCollectStats) {
+        Stats::OnNodeDestroyed();
+    }
+    if (compact_storage_ && compact_storage_->cursor == node) {
+        compact_storage_->cursor = nullptr;
+    }
+    if constexpr (kInlineNodes > 0) {
+        if (IsInline(node)) {
+            this->inline_used_ &= ~InlineBit(node);
+            node->~Node();
+            return;
+        }
+    }
+    if (compact_storage_) {
+        if (compact_storage_->pool.Owns(node)) {
+            node->~Node();
+            compact_storage_->pool.Deallocate(node);
+            return;
+        }
+    }
+    delete node;
+    if constexpr (kCollectStats) {
+        Stats::OnHeapFree(sizeof(Node));
+    }
+}
+
+// Отцепляет все узлы с тривиальными значениями. Деструкторы значений ничего не делают, а хэш и индекс позиций
+// Clear сбрасывает целиком, поэтому по одному освобождаются только узлы, выделенные в куче.
+// Ячейки слабов и встроенные ячейки становятся свободными разом. Когда узлов в куче нет,
+// а статистика не собирается, обходить список незачем
+template <typename Type>
+void SingleLinkedList<Type>::DropTrivialNodes() noexcept {
+    const size_t pooled = compact_storage_ ? compact_storage_->pool.GetLiveCount() : 0;
+    if (kCollectStats || pooled + GetInlineCount() != size_) {
+        for (Node* node = head_.next_node; node != nullptr;) {
+            Node* next = node->next_node;
+            if constexpr (kCollectStats) {
+                Stats::OnNodeDestroyed();
+            }
+            if (!IsInline(node) && (!compact_storage_ || !compact_storage_->pool.Owns(node))) {
+                delete node;
+                if constexpr (kCollectStats) {
+                    Stats::OnHeapFree(sizeof(Node));
+                }
+            }
+            node = next;
+        }
+    }
+    if (compact_storage_) {
+        compact_storage_->pool.DeallocateAll();
+    }
+    if constexpr (kInlineNodes > 0) {
+        this->inline_used_ = 0;
+    }
+    head_.next_node = nullptr;
+    size_ = 0;
+}
+
+// Освобождает слабы. Узлов в них к этому моменту быть не должно
+template <typename Type>
+void SingleLinkedList<Type>::ReleaseCompactStorage() noexcept {
+    if (!compact_storage_) {
+        return;
+    }
+    assert(compact_storage_->pool.GetLiveCount() == 0);
+    if constexpr (kCollectStats) {
+        const NodePool<Node>& pool = compact_storage_->pool;
+        Stats::OnHeapFree(pool.GetCapacity() * sizeof(Node), pool.GetSlabCount());
+    }
+    compact_storage_.reset();
+}
+
+// Забирает слабы other, чтобы его узлы можно было включить в этот список
+template <typename Type>
+void SingleLinkedList<Type>::AdoptCompactStorage(SingleLinkedList& other) {
+    if (!other.compact_storage_) {
+        return;
+    }
+    if (!compact_storage_) {
+        compact_storage_ = std::move(other.compact_storage_);
+        compact_storage_->cursor = nullptr;
+        return;
+    }
+    compact_storage_->pool.Merge(std::move(other.compact_storage_->pool));
+    other.compact_storage_.reset();
+}
+
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Node* SingleLinkedList<Type>::InlineCell(size_t index) const noexcept {
+    static_assert(sizeof(Node) == sizeof(list_inline_detail::NodeLayout<Type>)
+                  && alignof(Node) == alignof(list_inline_detail::NodeLayout<Type>));
+    assert(index < kInlineNodes);
+    const auto* cells = reinterpret_cast<const Node*>(this->inline_cells_);
+    return const_cast<Node*>(cells + index);
+}
+
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Node* SingleLinkedList<Type>::FreeInlineCell() const noexcept {
+    constexpr std::uint32_t kAllCells = kInlineNodes == 32 ? ~std::uint32_t{0} : (std::uint32_t{1} << kInlineNodes) - 1;
+    const std::uint32_t free_cells = ~this->inline_used_ & kAllCells;
+    if (free_cells == 0) {
+        return nullptr;
+    }
+    size_t index = 0;
+    while (((free_cells >> index) & 1u) == 0) {
+        ++index;
+    }
+    return InlineCell(index);
+}
+
+template <typename Type>
+[[nodiscard]] std::uint32_t SingleLinkedList<Type>::InlineBit(const Node* node) const noexcept {
+    return std::uint32_t{1} << (node - InlineCell(0));
+}
+
+// Лежит ли node во встроенной ячейке этого списка. Адреса разных объектов сравнивает std::less:
+// для них встроенные операторы сравнения не определены
+template <typename Type>
+[[nodiscard]] bool SingleLinkedList<Type>::IsInline(const Node* node) const noexcept {
+    if constexpr (kInlineNodes > 0) {
+        const Node* cells = InlineCell(0);
+        return !std::less<const Node*>()(node, cells) && std::less<const Node*>()(node, cells + kInlineNodes);
+    } else {
+        (void)node;
+        return false;
+    }
+}
+
+template <typename Type>
+[[nodiscard]] size_t SingleLinkedList<Type>::GetInlineCount() const noexcept {
+    size_t count = 0;
+    if constexpr (kInlineNodes > 0) {
+        for (std::uint32_t used = this->inline_used_; used != 0; used &= used - 1) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+// Обмен содержимым встроенных ячеек: элемент из ячейки i одного списка переезжает в ячейку i другого.
+// Вызывается из swap, когда головы и слабы уже обменяны. Затем ссылки на ячейки другого списка
+// переводятся на те же ячейки своего: для этого список обходится до последнего встроенного узла
+template <typename Type>
+void SingleLinkedList<Type>::SwapInlineNodes(SingleLinkedList& other) noexcept {
+    for (size_t i = 0; i < kInlineNodes; ++i) {
+        const std::uint32_t bit = std::uint32_t{1} << i;
+        Node* mine = InlineCell(i);
+        Node* theirs = other.InlineCell(i);
+        if ((this->inline_used_ & bit) != 0 && (other.inline_used_ & bit) != 0) {
+            Node temp(std::move(mine->value), mine->next_node);
+            mine->~Node();
+            new (mine) Node(std::move(theirs->value), theirs->next_node);
+            theirs->~Node();
+            new (theirs) Node(std::move(temp.value), temp.next_node);
+        } else if ((this->inline_used_ & bit) != 0) {
+            new (theirs) Node(std::move(mine->value), mine->next_node);
+            mine->~Node();
+        } else if ((other.inline_used_ & bit) != 0) {
+            new (mine) Node(std::move(theirs->value), theirs->next_node);
+            theirs->~Node();
+        }
+    }
+    std::swap(this->inline_used_, other.inline_used_);
+
+    for (SingleLinkedList* list : {this, &other}) {
+        const SingleLinkedList& from = list == this ? other : *this;
+        size_t remaining = list->GetInlineCount();
+        for (Node* node = &list->head_; remaining > 0; node = node->next_node) {
+            if (from.IsInline(node->next_node)) {
+                node->next_node = list->InlineCell(static_cast<size_t>(node->next_node - from.InlineCell(0)));
+                --remaining;
+            }
+        }
+        if (list->compact_storage_ && (list->IsInline(list->compact_storage_->cursor)
+                                       || from.IsInline(list->compact_storage_->cursor))) {
+            list->compact_storage_->cursor = nullptr;
+        }
+        list->InvalidatePositionIndex();
+    }
+}
+
+// Переносит узлы из встроенных ячеек other в свободные ячейки этого списка, а не поместившиеся - в кучу,
+// и забирает слабы other. Возвращает последний узел other. Память в куче выделяется до любых изменений:
+// если её не хватит, оба списка останутся прежними
+template <typename Type>
+[[nodiscard]] typename SingleLinkedList<Type>::Node* SingleLinkedList<Type>::MoveInlineNodes(SingleLinkedList& other) {
+    const size_t moving = other.GetInlineCount();
+    const size_t free_cells = kInlineNodes - GetInlineCount();
+    std::array<void*, kInlineNodes> blocks{};
+    size_t block_count = 0;
+    try {
+        for (; block_count + free_cells < moving; ++block_count) {
+            blocks[block_count] = ::operator new(sizeof(Node));
+        }
+        AdoptCompactStorage(other);
+    } catch (...) {
+        for (size_t i = 0; i < block_count; ++i) {
+            ::operator delete(blocks[i]);
+        }
+        throw;
+    }
+
+    Node* prev = &other.head_;
+    for (Node* node = prev->next_node; node != nullptr; prev = node, node = node->next_node) {
+        if (!other.IsInline(node)) {
+            continue;
+        }
+        Node* cell = FreeInlineCell();
+        Node* moved = new (cell != nullptr ? cell : blocks[--block_count]) Node(std::move(node->value), node->next_node);
+        if (cell != nullptr) {
+            this->inline_used_ |= InlineBit(moved);
+        } else if constexpr (kCollectStats) {
+            Stats::OnHeapAllocate(sizeof(Node));
+        }
+        if constexpr (kCollectStats) {
+            Stats::OnNodeCreated();
+        }
+        prev->next_node = moved;
+        other.DestroyNode(node);
+        node = moved;
+    }
+    return prev;
 }
 
 // Перегрузка оператора присвоения
@@ -160,14 +1287,66 @@ SingleLinkedList<Type>& SingleLinkedList<Type>::operator=(const SingleLinkedList
     return *this;
 }
 
+// Перегрузка перемещающего оператора присвоения
+template <typename Type>
+SingleLinkedList<Type>& SingleLinkedList<Type>::operator=(SingleLinkedList<Type>&& rhs) noexcept {
+    if (this != &rhs) {
+        SingleLinkedList tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+// Копирует значения other по порядку. Длинная копия тривиальных значений (см. ListTrivialValues)
+// занимает один слаб, как после Compact: одно обращение к куче вместо одного на узел,
+// значения переносятся через memcpy, а узлы копии лежат в памяти подряд
 template <typename Type>
 template <typename TList>
 void SingleLinkedList<Type>::CopyList(TList& other) {
     SingleLinkedList tmp;
     Iterator node_it = tmp.before_begin();
-    for (const auto& val : other) {
-        ++node_it = InsertAfter(node_it, val);
-        ++tmp.size_;
+    auto source = other.begin();
+    size_t left = 0;
+    if constexpr (std::is_same_v<std::remove_const_t<TList>, SingleLinkedList>) {
+        left = other.GetSize();
+    } else {
+        left = other.size();
+    }
+
+    if constexpr (kTrivialValues) {
+        if (left >= kMinSlabCopy) {
+            // Встроенные ячейки заполняются первыми, как при поэлементной вставке
+            if constexpr (kInlineNodes > 0) {
+                for (; left > 0 && tmp.size_ < kInlineNodes; --left, ++source) {
+                    node_it = tmp.InsertAfter(node_it, *source);
+                }
+            }
+            if (left > 0) {
+                tmp.compact_storage_ = std::make_unique<CompactStorage>();
+                Node* slab = tmp.compact_storage_->pool.AllocateSlab(left);
+                if constexpr (kCollectStats) {
+                    Stats::OnHeapAllocate(left * sizeof(Node));
+                }
+                tmp.InvalidateHash();
+                tmp.InvalidatePositionIndex();
+                Node* tail = node_it.node_;
+                for (size_t i = 0; i < left; ++i, ++source) {
+                    Node* node = new (slab + i) Node;
+                    std::memcpy(&node->value, std::addressof(*source), sizeof(Type));
+                    tail->next_node = node;
+                    tail = node;
+                    if constexpr (kCollectStats) {
+                        Stats::OnNodeCreated();
+                        Stats::OnValueCopied();
+                    }
+                }
+                tmp.size_ += left;
+                left = 0;
+            }
+        }
+    }
+    for (; left > 0; --left, ++source) {
+        node_it = tmp.InsertAfter(node_it, *source);
     }
     swap(tmp);
 }
@@ -177,9 +1356,13 @@ void swap(SingleLinkedList<Type>& lhs, SingleLinkedList<Type>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+// Списки разной длины не равны без обхода элементов
 template <typename Type>
 bool operator==(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
-    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    if (&lhs == &rhs) {
+        return true;
+    }
+    return lhs.GetSize() == rhs.GetSize() && lhs.EqualElements(rhs);
 }
 
 template <typename Type>
@@ -211,15 +1394,27 @@ bool operator>=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>&
 template <typename Type>
 struct SingleLinkedList<Type>::Node {
     Node() = default;
-    Node(const Type& val, Node* next)
+    Node(const Type& val, Node* next) noexcept(std::is_nothrow_copy_constructible_v<Type>)
         : value(val)
         , next_node(next) {
     }
+    Node(Type&& val, Node* next) noexcept(std::is_nothrow_move_constructible_v<Type>)
+        : value(std::move(val))
+        , next_node(next) {
+    }
 
     Type value;
     Node* next_node = nullptr;
 };
 
+// Слабы уплотнённых узлов и позиция, на которой остановилось пошаговое уплотнение
+// (предшественник следующего узла; nullptr - начало списка)
+template <typename Type>
+struct SingleLinkedList<Type>::CompactStorage {
+    NodePool<Node> pool;
+    Node* cursor = nullptr;
+};
+
 template <typename Type>
 template <typename ValueType>
 class SingleLinkedList<Type>::BasicIterator {
@@ -343,3 +1538,13 @@ template <typename ValueType>
               (const BasicIterator<Type>& rhs) const noexcept {
     return node_ != rhs.node_;
 }
+
+// Хэш списка для std::unordered_set/unordered_map: согласован с operator==
+namespace std {
+template <typename Type>
+struct hash<SingleLinkedList<Type>> {
+    [[nodiscard]] size_t operator()(const SingleLinkedList<Type>& list) const {
+        return list.GetHash();
+    }
+};
+} // namespace std
@@ -2,11 +2,32 @@ TEMPLATE = app
 CONFIG += console c++17
 CONFIG -= app_bundle
 CONFIG -= qt
+CONFIG += thread
 
 SOURCES += \
         TestsSingleLinkedList.cpp \
         main.cpp
 
 HEADERS += \
+    ConstexprSingleLinkedList.h \
+    CowSingleLinkedList.h \
+    HashIndexedSingleLinkedList.h \
+    LinkedHashMap.h \
+    LruCache.h \
+    MappedSingleLinkedList.h \
+    NodePool.h \
+    ParallelSingleLinkedList.h \
+    PersistentSingleLinkedList.h \
+    PrefetchSingleLinkedList.h \
+    ShardedSingleLinkedList.h \
     SingleLinkedList.h \
+    SingleLinkedListHash.h \
+    SingleLinkedListIndex.h \
+    SingleLinkedListInline.h \
+    SingleLinkedListMemory.h \
+    SingleLinkedListSerialization.h \
+    SingleLinkedListStats.h \
+    SortedSingleLinkedList.h \
+    StaticSingleLinkedList.h \
+    StreamingSingleLinkedList.h \
     TestsSingleLinkedList.h
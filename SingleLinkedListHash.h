@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Хэширование содержимого списков SingleLinkedList<Type>.
+// Хэш списка v0, v1, ..., vn-1 - многочлен h(v0) + h(v1)*P + ... + h(vn-1)*P^(n-1) по модулю 2^64,
+// поэтому добавление и удаление первого элемента пересчитывают его за O(1).
+// Кэширование хэша в самом списке включается для типов, у которых EnableListHashCache<Type>::value == true,
+// или для всех типов сразу макросом SINGLE_LINKED_LIST_HASH_CACHE (в .pro-файле: DEFINES += SINGLE_LINKED_LIST_HASH_CACHE)
+#ifdef SINGLE_LINKED_LIST_HASH_CACHE
+inline constexpr bool kSingleLinkedListHashCacheByDefault = true;
+#else
+inline constexpr bool kSingleLinkedListHashCacheByDefault = false;
+#endif
+
+// Точка настройки: значения Type равны тогда и только тогда, когда совпадают их байты,
+// и сравнение не может выбросить исключение. Для таких типов operator== сравнивает
+// подряд лежащие узлы пачками без досрочного выхода на каждом элементе,
+// а хэш вычисляется по байтам значения без обращения к std::hash
+template <typename Type>
+struct IsBitwiseComparable
+    : std::bool_constant<(std::is_integral_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>)
+                         && std::has_unique_object_representations_v<Type>> {};
+
+// Точка настройки: специализация с value = true включает кэш хэша в списках Type.
+// Макрос включает кэш только для типов, которые можно хэшировать
+template <typename Type>
+struct EnableListHashCache
+    : std::bool_constant<kSingleLinkedListHashCacheByDefault
+                         && (IsBitwiseComparable<Type>::value || std::is_default_constructible_v<std::hash<Type>>)> {};
+
+namespace list_hash_detail {
+
+// Основание многочлена. Нечётное, поэтому обратимо по модулю 2^64
+inline constexpr std::uint64_t kBase = 0x9E3779B97F4A7C15ull;
+
+// Обратный по модулю 2^64 элемент для нечётного value (итерации Ньютона удваивают число верных бит)
+[[nodiscard]] constexpr std::uint64_t InverseOdd(std::uint64_t value) noexcept {
+    std::uint64_t inverse = value;
+    for (int i = 0; i < 6; ++i) {
+        inverse *= 2 - value * inverse;
+    }
+    return inverse;
+}
+
+inline constexpr std::uint64_t kBaseInverse = InverseOdd(kBase);
+static_assert(kBase * kBaseInverse == 1);
+
+// Перемешивание бит (финализатор MurmurHash3), чтобы слабые хэши вроде тождественного std::hash<int>
+// не давали коллизий в многочлене
+[[nodiscard]] constexpr std::uint64_t Mix(std::uint64_t value) noexcept {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+// Может ли хэширование значения выбросить исключение
+template <typename Type>
+inline constexpr bool kNothrowHash = IsBitwiseComparable<Type>::value
+                                     || noexcept(std::hash<Type>{}(std::declval<const Type&>()));
+
+// Хэш одного значения
+template <typename Type>
+[[nodiscard]] std::uint64_t HashValue(const Type& value) noexcept(kNothrowHash<Type>) {
+    if constexpr (IsBitwiseComparable<Type>::value) {
+        std::uint64_t words[(sizeof(Type) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)] = {};
+        std::memcpy(words, &value, sizeof(Type));
+        std::uint64_t hash = 0;
+        for (std::uint64_t word : words) {
+            hash = Mix(hash ^ word);
+        }
+        return hash;
+    } else {
+        return Mix(static_cast<std::uint64_t>(std::hash<Type>{}(value)));
+    }
+}
+
+// Итоговый хэш списка: многочлен и длина
+[[nodiscard]] constexpr size_t Finalize(std::uint64_t polynomial, size_t size) noexcept {
+    return static_cast<size_t>(Mix(polynomial ^ Mix(size)));
+}
+
+// Кэш многочлена. Пустой, если кэширование выключено, и тогда не занимает места в списке
+template <bool Enabled>
+struct HashCache {
+    mutable std::uint64_t hash_polynomial_ = 0;     // Многочлен пустого списка
+    mutable bool hash_valid_ = true;
+};
+
+template <>
+struct HashCache<false> {
+};
+
+} // namespace list_hash_detail
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Индекс позиций для SingleLinkedList<Type>::At, IteratorAt и Advance.
+// Индекс - массив контрольных точек: узлов, расстояние от которых до конца списка кратно kListIndexStride.
+// Позиции считаются от конца, поэтому PushFront/PopFront и вставка/удаление первого элемента поддерживают
+// индекс за O(1), а от любого узла до ближайшей контрольной точки не больше kListIndexStride шагов.
+// Остальные изменения списка сбрасывают индекс; он строится заново за O(N) при следующем позиционном запросе
+// через неконстантный список. Константные At, IteratorAt и Advance индекс не меняют: пока он сброшен,
+// они обходят список, как без индекса. Поэтому одновременные константные обращения к списку из разных
+// потоков безопасны, как и без индекса; изменения и неконстантные обращения требуют внешней синхронизации.
+// Индекс включается для типов, у которых EnableListPositionIndex<Type>::value == true,
+// или для всех типов сразу макросом SINGLE_LINKED_LIST_POSITION_INDEX
+// (в .pro-файле: DEFINES += SINGLE_LINKED_LIST_POSITION_INDEX). Без индекса те же методы обходят список
+#ifdef SINGLE_LINKED_LIST_POSITION_INDEX
+inline constexpr bool kSingleLinkedListPositionIndexByDefault = true;
+#else
+inline constexpr bool kSingleLinkedListPositionIndexByDefault = false;
+#endif
+
+// Расстояние между соседними контрольными точками
+inline constexpr size_t kListIndexStride = 32;
+
+// Точка настройки: специализация с value = true включает индекс позиций в списках Type
+template <typename Type>
+struct EnableListPositionIndex : std::bool_constant<kSingleLinkedListPositionIndexByDefault> {};
+
+namespace list_index_detail {
+
+// Контрольные точки: index_checkpoints_[j] - узел, после которого в списке ровно j * kListIndexStride узлов.
+// index_lookup_ - те же точки, упорядоченные по адресу узла, чтобы узнать номер точки по итератору (для Advance);
+// строится при первом неконстантном обращении после изменения набора точек.
+// Узлы хранятся как void*, потому что тип узла объявлен внутри SingleLinkedList.
+// Пустой, если индекс выключен, и тогда не занимает места в списке
+template <bool Enabled>
+struct PositionIndex {
+    std::vector<void*> index_checkpoints_;
+    std::vector<std::pair<const void*, size_t>> index_lookup_;
+    bool index_valid_ = true;               // Индекс пустого списка пуст
+    bool index_lookup_valid_ = true;
+};
+
+template <>
+struct PositionIndex<false> {
+};
+
+} // namespace list_index_detail
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Встроенные узлы SingleLinkedList<Type>: первые ListInlineNodes<Type>::value узлов размещаются в ячейках
+// внутри самого объекта списка, а следующие - в куче, как обычно. Короткие списки не обращаются
+// к распределителю памяти вовсе. Занятые ячейки не перемещаются, когда список вырастает за их число,
+// поэтому итераторы остаются действительными. Перемещение и обмен списков переносят элементы из ячеек
+// одного списка в те же ячейки другого: итераторы на такие элементы нужно пересчитать (SingleLinkedList::Relocated).
+// Ссылку на ячейку может держать любой узел списка, поэтому обмен и перемещение со встроенными узлами
+// обходят список и занимают время O(N), а не O(1).
+// Число ячеек задаётся специализацией ListInlineNodes<Type> или для всех типов сразу макросом
+// SINGLE_LINKED_LIST_INLINE_NODES (в .pro-файле: DEFINES += SINGLE_LINKED_LIST_INLINE_NODES=4).
+// По умолчанию ячеек нет, и список не меняется ни по размеру, ни по поведению
+#ifdef SINGLE_LINKED_LIST_INLINE_NODES
+inline constexpr size_t kSingleLinkedListInlineNodesByDefault = SINGLE_LINKED_LIST_INLINE_NODES;
+#else
+inline constexpr size_t kSingleLinkedListInlineNodesByDefault = 0;
+#endif
+
+// Занятость ячеек хранится битами одного слова
+inline constexpr size_t kMaxListInlineNodes = 32;
+
+// Точка настройки: специализация с другим value задаёт число встроенных узлов в списках Type.
+// Обмен списков переносит элементы между ячейками без права на исключение, поэтому макрос
+// не включает ячейки для типов, перемещение которых может выбросить исключение
+template <typename Type>
+struct ListInlineNodes
+    : std::integral_constant<size_t, std::is_nothrow_move_constructible_v<Type>
+                                     ? kSingleLinkedListInlineNodesByDefault : 0> {};
+
+namespace list_inline_detail {
+
+// То же устройство, что у SingleLinkedList<Type>::Node, который ещё не определён там, где выбирается база списка
+template <typename Type>
+struct NodeLayout {
+    Type value;
+    void* next_node;
+};
+
+// Ячейки под Count узлов и биты их занятости. Пустой при Count == 0, и тогда не занимает места в списке
+template <typename Type, size_t Count>
+struct InlineNodes {
+    static_assert(Count <= kMaxListInlineNodes, "Too many inline nodes");
+
+    // Ячейки не обнуляются: их содержимое значимо, только пока занят бит
+    InlineNodes() noexcept {}
+
+    alignas(NodeLayout<Type>) unsigned char inline_cells_[Count * sizeof(NodeLayout<Type>)];
+    std::uint32_t inline_used_ = 0;     // Бит i - ячейка i занята
+};
+
+template <typename Type>
+struct InlineNodes<Type, 0> {
+};
+
+} // namespace list_inline_detail
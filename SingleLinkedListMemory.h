@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "NodePool.h"
+
+// Точка настройки: сколько памяти в куче принадлежит значению Type помимо sizeof(Type).
+// Специализация должна объявить kOwnsHeapMemory = true и функцию Get, возвращающую
+// размер принадлежащих значению блоков с учётом служебных данных malloc (см. EstimateMallocChunkSize).
+// Для типов без специализации считается, что собственной памяти в куче у значения нет
+template <typename Type>
+struct ValueHeapUsage {
+    static constexpr bool kOwnsHeapMemory = false;
+
+    [[nodiscard]] static size_t Get(const Type&) noexcept {
+        return 0;
+    }
+};
+
+// Строка держит буфер в куче, только если он не поместился во внутренний (SSO) буфер объекта
+template <typename CharT, typename Traits, typename Allocator>
+struct ValueHeapUsage<std::basic_string<CharT, Traits, Allocator>> {
+    static constexpr bool kOwnsHeapMemory = true;
+
+    [[nodiscard]] static size_t Get(const std::basic_string<CharT, Traits, Allocator>& value) noexcept {
+        const void* data = value.data();
+        const bool inline_buffer = std::less_equal<const void*>{}(&value, data)
+            && std::less<const void*>{}(data, &value + 1);
+        return inline_buffer ? 0 : EstimateMallocChunkSize((value.capacity() + 1) * sizeof(CharT));
+    }
+};
+
+// Буфер вектора и, если элементы сами владеют памятью, их собственные блоки
+template <typename T, typename Allocator>
+struct ValueHeapUsage<std::vector<T, Allocator>> {
+    static constexpr bool kOwnsHeapMemory = true;
+
+    [[nodiscard]] static size_t Get(const std::vector<T, Allocator>& value) noexcept {
+        size_t bytes = value.capacity() == 0 ? 0 : EstimateMallocChunkSize(value.capacity() * sizeof(T));
+        if constexpr (ValueHeapUsage<T>::kOwnsHeapMemory) {
+            for (const T& element : value) {
+                bytes += ValueHeapUsage<T>::Get(element);
+            }
+        }
+        return bytes;
+    }
+};
+
+// Точка настройки: можно ли обращаться со значениями Type как с байтами - копировать узлы через memcpy
+// и освобождать их, не вызывая деструкторов. По умолчанию так для тривиально копируемых типов
+// с конструктором по умолчанию (int, double, POD-структуры); специализация с value = false
+// возвращает спискам Type обычный поэлементный путь
+template <typename Type>
+struct ListTrivialValues
+    : std::bool_constant<std::is_trivially_copyable_v<Type> && std::is_default_constructible_v<Type>> {};
+
+// Разбивка памяти, которую занимает список
+struct ListMemoryUsage {
+    size_t node_count = 0;          // Элементы списка
+    size_t node_size = 0;           // sizeof(Node)
+    size_t node_alignment = 0;      // alignof(Node)
+    size_t node_padding = 0;        // Байты выравнивания внутри одного узла
+    size_t heap_nodes = 0;          // Узлы, выделенные в куче по одному
+    size_t pooled_nodes = 0;        // Узлы в слабах уплотнённого списка
+    size_t inline_nodes = 0;        // Узлы во встроенных ячейках самого списка (см. ListInlineNodes)
+    size_t node_bytes = 0;          // node_count * node_size
+    size_t allocator_overhead = 0;  // Служебные данные malloc и незанятые ячейки слабов
+    size_t value_heap_bytes = 0;    // Память в куче, которой владеют сами значения (см. ValueHeapUsage)
+    size_t container_bytes = 0;     // Объект списка и его служебные структуры
+
+    [[nodiscard]] size_t GetTotalBytes() const noexcept {
+        return node_bytes + allocator_overhead + value_heap_bytes + container_bytes;
+    }
+
+    // Полная стоимость элемента (0 для пустого списка)
+    [[nodiscard]] double GetBytesPerElement() const noexcept {
+        return node_count == 0 ? 0.0 : static_cast<double>(GetTotalBytes()) / static_cast<double>(node_count);
+    }
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Двоичный формат списка: заголовок ListSerializationHeader и следом значения в порядке обхода.
+// Числа записываются в порядке байт текущей платформы
+
+// Приёмник байт: поток или буфер в памяти (данные дописываются в конец буфера)
+class ListByteWriter {
+public:
+    explicit ListByteWriter(std::ostream& out) noexcept : out_(&out) {}
+    explicit ListByteWriter(std::vector<char>& buffer) noexcept : buffer_(&buffer) {}
+
+    void Write(const void* data, size_t size);
+
+    // Место под size байт прямо в буфере (nullptr, если запись идёт в поток)
+    [[nodiscard]] char* Reserve(size_t size);
+
+    template <typename T>
+    void WriteValue(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(&value, sizeof(T));
+    }
+
+private:
+    std::ostream* out_ = nullptr;
+    std::vector<char>* buffer_ = nullptr;
+};
+
+// Источник байт: поток или непрерывный буфер. Нехватка данных - исключение std::runtime_error
+class ListByteReader {
+public:
+    explicit ListByteReader(std::istream& in) noexcept : in_(&in) {}
+    ListByteReader(const char* data, size_t size) noexcept : data_(data), end_(data + size) {}
+
+    void Read(void* data, size_t size);
+
+    // Следующие size байт прямо из буфера без копирования (nullptr, если чтение идёт из потока)
+    [[nodiscard]] const char* View(size_t size);
+
+    // Сколько байт осталось в буфере (для потока неизвестно)
+    [[nodiscard]] bool HasKnownSize() const noexcept {return in_ == nullptr;}
+    [[nodiscard]] size_t GetRemaining() const noexcept {return static_cast<size_t>(end_ - data_);}
+
+    template <typename T>
+    [[nodiscard]] T ReadValue() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        Read(&value, sizeof(T));
+        return value;
+    }
+
+private:
+    std::istream* in_ = nullptr;
+    const char* data_ = nullptr;
+    const char* end_ = nullptr;
+};
+
+inline void ListByteWriter::Write(const void* data, size_t size) {
+    if (buffer_ != nullptr) {
+        std::memcpy(Reserve(size), data, size);
+        return;
+    }
+    if (!out_->write(static_cast<const char*>(data), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("SingleLinkedList serialization: write failed");
+    }
+}
+
+[[nodiscard]] inline char* ListByteWriter::Reserve(size_t size) {
+    if (buffer_ == nullptr) {
+        return nullptr;
+    }
+    const size_t offset = buffer_->size();
+    buffer_->resize(offset + size);
+    return buffer_->data() + offset;
+}
+
+inline void ListByteReader::Read(void* data, size_t size) {
+    if (in_ == nullptr) {
+        std::memcpy(data, View(size), size);
+        return;
+    }
+    if (!in_->read(static_cast<char*>(data), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("SingleLinkedList deserialization: unexpected end of stream");
+    }
+}
+
+[[nodiscard]] inline const char* ListByteReader::View(size_t size) {
+    if (in_ != nullptr) {
+        return nullptr;
+    }
+    if (size > GetRemaining()) {
+        throw std::runtime_error("SingleLinkedList deserialization: unexpected end of buffer");
+    }
+    const char* data = data_;
+    data_ += size;
+    return data;
+}
+
+// Точка настройки: как записывать и читать значения Type.
+// Тривиально копируемые типы (кроме указателей) записываются байтами, пачками через memcpy.
+// Для остальных нужна специализация с kBitwise = false и функциями
+//   static void Encode(const Type& value, ListByteWriter& writer);
+//   static Type Decode(ListByteReader& reader);
+template <typename Type>
+struct ListValueCodec {
+    static constexpr bool kBitwise = std::is_trivially_copyable_v<Type> && std::is_default_constructible_v<Type>
+                                     && !std::is_pointer_v<Type>;
+};
+
+// Строка: длина и символы. Из потока длину не с чем сверить, поэтому строка читается кусками
+// и растёт только по мере прихода байт: повреждённая длина упирается в конец данных
+template <typename CharT, typename Traits, typename Allocator>
+struct ListValueCodec<std::basic_string<CharT, Traits, Allocator>> {
+    static constexpr bool kBitwise = false;
+    static constexpr size_t kChunkChars = std::max<size_t>(1, (64 << 10) / sizeof(CharT));
+
+    static void Encode(const std::basic_string<CharT, Traits, Allocator>& value, ListByteWriter& writer) {
+        writer.WriteValue(static_cast<std::uint64_t>(value.size()));
+        writer.Write(value.data(), value.size() * sizeof(CharT));
+    }
+
+    [[nodiscard]] static std::basic_string<CharT, Traits, Allocator> Decode(ListByteReader& reader) {
+        const auto size = reader.ReadValue<std::uint64_t>();
+        std::basic_string<CharT, Traits, Allocator> value;
+        if (reader.HasKnownSize() ? size > reader.GetRemaining() / sizeof(CharT) : size > value.max_size()) {
+            throw std::runtime_error("SingleLinkedList deserialization: string length exceeds input");
+        }
+        if (reader.HasKnownSize()) {
+            value.resize(static_cast<size_t>(size));
+            reader.Read(value.data(), value.size() * sizeof(CharT));
+            return value;
+        }
+        while (value.size() < size) {
+            const size_t offset = value.size();
+            const size_t chunk = static_cast<size_t>(std::min<std::uint64_t>(size - offset, kChunkChars));
+            value.resize(offset + chunk);
+            reader.Read(value.data() + offset, chunk * sizeof(CharT));
+        }
+        return value;
+    }
+};
+
+// Заголовок сериализованного списка
+struct ListSerializationHeader {
+    static constexpr char kMagic[4] = {'S', 'L', 'L', '1'};
+
+    char magic[4] = {kMagic[0], kMagic[1], kMagic[2], kMagic[3]};
+    std::uint32_t value_size = 0;   // sizeof(Type) для побайтовой записи, 0 - значения закодированы кодеком
+    std::uint64_t count = 0;        // Количество элементов (GetSize())
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+// Статистика выделений памяти списками SingleLinkedList<Type>.
+// Собирается только для типов, у которых EnableListStats<Type>::value == true;
+// для остальных все обращения к счётчикам вырезаются при компиляции.
+// Сбор для всех типов сразу включается макросом SINGLE_LINKED_LIST_STATS
+// (в .pro-файле: DEFINES += SINGLE_LINKED_LIST_STATS)
+#ifdef SINGLE_LINKED_LIST_STATS
+inline constexpr bool kSingleLinkedListStatsByDefault = true;
+#else
+inline constexpr bool kSingleLinkedListStatsByDefault = false;
+#endif
+
+// Точка настройки: специализация с value = true включает сбор статистики для списков Type
+template <typename Type>
+struct EnableListStats : std::bool_constant<kSingleLinkedListStatsByDefault> {};
+
+// Снимок счётчиков
+struct ListStats {
+    size_t heap_allocations = 0;    // Обращения к куче за памятью под узлы (отдельные узлы и слабы)
+    size_t heap_frees = 0;          // Возвраты памяти узлов в кучу
+    size_t bytes_outstanding = 0;   // Запрошенная у кучи и ещё не возвращённая память под узлы
+    size_t nodes_created = 0;       // Созданные узлы
+    size_t nodes_destroyed = 0;     // Разрушенные узлы
+    size_t live_nodes = 0;          // Существующие в данный момент узлы
+    size_t peak_nodes = 0;          // Наибольшее число одновременно существующих узлов
+    size_t value_copies = 0;        // Копирования значений Type в узлы
+};
+
+// Глобальные счётчики всех списков SingleLinkedList<Type>. Потокобезопасны
+template <typename Type>
+class ListStatsRegistry {
+public:
+    static void OnHeapAllocate(size_t bytes) noexcept {
+        heap_allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_outstanding_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void OnHeapFree(size_t bytes, size_t calls = 1) noexcept {
+        heap_frees_.fetch_add(calls, std::memory_order_relaxed);
+        bytes_outstanding_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    static void OnNodeCreated() noexcept {
+        nodes_created_.fetch_add(1, std::memory_order_relaxed);
+        const size_t live = live_nodes_.fetch_add(1, std::memory_order_relaxed) + 1;
+        size_t peak = peak_nodes_.load(std::memory_order_relaxed);
+        while (live > peak && !peak_nodes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void OnNodeDestroyed() noexcept {
+        nodes_destroyed_.fetch_add(1, std::memory_order_relaxed);
+        live_nodes_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    static void OnValueCopied() noexcept {
+        value_copies_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static ListStats Get() noexcept {
+        ListStats stats;
+        stats.heap_allocations = heap_allocations_.load(std::memory_order_relaxed);
+        stats.heap_frees = heap_frees_.load(std::memory_order_relaxed);
+        stats.bytes_outstanding = bytes_outstanding_.load(std::memory_order_relaxed);
+        stats.nodes_created = nodes_created_.load(std::memory_order_relaxed);
+        stats.nodes_destroyed = nodes_destroyed_.load(std::memory_order_relaxed);
+        stats.live_nodes = live_nodes_.load(std::memory_order_relaxed);
+        stats.peak_nodes = peak_nodes_.load(std::memory_order_relaxed);
+        stats.value_copies = value_copies_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // Обнуляет счётчики событий. Существующие узлы и занятая ими память продолжают учитываться:
+    // live_nodes и bytes_outstanding не меняются, а пик опускается до текущего числа узлов
+    static void Reset() noexcept {
+        heap_allocations_.store(0, std::memory_order_relaxed);
+        heap_frees_.store(0, std::memory_order_relaxed);
+        nodes_created_.store(0, std::memory_order_relaxed);
+        nodes_destroyed_.store(0, std::memory_order_relaxed);
+        peak_nodes_.store(live_nodes_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        value_copies_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<size_t> heap_allocations_{0};
+    static inline std::atomic<size_t> heap_frees_{0};
+    static inline std::atomic<size_t> bytes_outstanding_{0};
+    static inline std::atomic<size_t> nodes_created_{0};
+    static inline std::atomic<size_t> nodes_destroyed_{0};
+    static inline std::atomic<size_t> live_nodes_{0};
+    static inline std::atomic<size_t> peak_nodes_{0};
+    static inline std::atomic<size_t> value_copies_{0};
+};
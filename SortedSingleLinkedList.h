@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "SingleLinkedList.h"
+
+// Желаемая длина отрезка между соседними опорными узлами SortedSingleLinkedList.
+// Отрезки держатся в пределах от kSortedListSegment / 2 до 2 * kSortedListSegment элементов
+inline constexpr size_t kSortedListSegment = 32;
+
+// Упорядоченный по Compare односвязный список. Элементы хранятся в обычном SingleLinkedList,
+// а рядом - массив опорных узлов: первый узел каждого отрезка и длина отрезка.
+// Поиск места делается двоичным поиском по опорным узлам и проходом внутри одного отрезка,
+// поэтому InsertSorted, LowerBound, Find и EraseValue работают за O(log N + kSortedListSegment).
+// Равные элементы хранятся в порядке вставки. Элементы доступны только для чтения
+template <typename Type, typename Compare = std::less<Type>>
+class SortedSingleLinkedList {
+public:
+    using ConstIterator = typename SingleLinkedList<Type>::ConstIterator;
+
+    using value_type = Type;
+    using reference = const Type&;
+    using const_reference = const Type&;
+    using iterator = ConstIterator;
+    using const_iterator = ConstIterator;
+
+    SortedSingleLinkedList() = default;
+    explicit SortedSingleLinkedList(const Compare& comp) : comp_(comp) {}
+    SortedSingleLinkedList(std::initializer_list<Type> values, const Compare& comp = Compare());
+    template <typename InputIt>
+    SortedSingleLinkedList(InputIt first, InputIt last, const Compare& comp = Compare());
+    SortedSingleLinkedList(const SortedSingleLinkedList& other);
+    SortedSingleLinkedList(SortedSingleLinkedList&& other) noexcept;
+
+    SortedSingleLinkedList& operator=(const SortedSingleLinkedList& rhs);
+    SortedSingleLinkedList& operator=(SortedSingleLinkedList&& rhs) noexcept;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return list_.GetSize();}
+    [[nodiscard]] bool IsEmpty() const noexcept {return list_.IsEmpty();}
+
+    // Вставляет value после всех равных ему элементов. Возвращает итератор на вставленный элемент
+    ConstIterator InsertSorted(const Type& value);
+    // Первый элемент, не меньший value (end(), если такого нет)
+    [[nodiscard]] ConstIterator LowerBound(const Type& value) const;
+    // Первый элемент, больший value (end(), если такого нет)
+    [[nodiscard]] ConstIterator UpperBound(const Type& value) const;
+    // Первый элемент, равный value (end(), если такого нет)
+    [[nodiscard]] ConstIterator Find(const Type& value) const;
+    // Удаляет все элементы, равные value. Возвращает количество удалённых
+    size_t EraseValue(const Type& value);
+
+    void Clear() noexcept;
+    void swap(SortedSingleLinkedList& other) noexcept;
+
+    // Сам список: узлы лежат так же, как в любом SingleLinkedList
+    [[nodiscard]] const SingleLinkedList<Type>& GetList() const noexcept {return list_;}
+
+    [[nodiscard]] ConstIterator begin() const noexcept {return list_.cbegin();}
+    [[nodiscard]] ConstIterator end() const noexcept {return list_.cend();}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+
+private:
+    // Отрезок списка: первый узел и количество элементов. Отрезки идут подряд и покрывают весь список
+    struct Segment {
+        ConstIterator first;
+        size_t count = 0;
+    };
+
+    // Место в списке: узел перед искомой позицией (before_begin, если она в начале)
+    // и отрезок, в котором этот узел лежит
+    struct Position {
+        size_t segment = 0;
+        ConstIterator prev;
+    };
+
+    SingleLinkedList<Type> list_;
+    std::vector<Segment> segments_;
+    Compare comp_;
+
+    template <typename Before>
+    [[nodiscard]] Position Locate(Before before) const;
+    void SplitSegment(size_t segment) noexcept;
+    [[nodiscard]] size_t MergeSegment(size_t segment) noexcept;
+    void RebuildSegments();
+    void RelocateSegments(const SingleLinkedList<Type>& from) noexcept;
+};
+
+template <typename Type, typename Compare>
+SortedSingleLinkedList<Type, Compare>::SortedSingleLinkedList(std::initializer_list<Type> values, const Compare& comp)
+    : SortedSingleLinkedList(values.begin(), values.end(), comp) {
+}
+
+template <typename Type, typename Compare>
+template <typename InputIt>
+SortedSingleLinkedList<Type, Compare>::SortedSingleLinkedList(InputIt first, InputIt last, const Compare& comp)
+    : comp_(comp) {
+    for (; first != last; ++first) {
+        InsertSorted(*first);
+    }
+}
+
+// Узлы копии лежат по другим адресам, поэтому опорные узлы выбираются заново
+template <typename Type, typename Compare>
+SortedSingleLinkedList<Type, Compare>::SortedSingleLinkedList(const SortedSingleLinkedList& other)
+    : list_(other.list_)
+    , comp_(other.comp_) {
+    RebuildSegments();
+}
+
+// Перемещение списка не перемещает узлы, кроме встроенных, поэтому опорные узлы остаются действительными
+// после пересчёта встроенных
+template <typename Type, typename Compare>
+SortedSingleLinkedList<Type, Compare>::SortedSingleLinkedList(SortedSingleLinkedList&& other) noexcept
+    : list_(std::move(other.list_))
+    , segments_(std::move(other.segments_))
+    , comp_(other.comp_) {
+    other.segments_.clear();
+    RelocateSegments(other.list_);
+}
+
+template <typename Type, typename Compare>
+SortedSingleLinkedList<Type, Compare>& SortedSingleLinkedList<Type, Compare>::operator=(
+        const SortedSingleLinkedList& rhs) {
+    if (this != &rhs) {
+        SortedSingleLinkedList tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template <typename Type, typename Compare>
+SortedSingleLinkedList<Type, Compare>& SortedSingleLinkedList<Type, Compare>::operator=(
+        SortedSingleLinkedList&& rhs) noexcept {
+    if (this != &rhs) {
+        SortedSingleLinkedList tmp(std::move(rhs));
+        swap(tmp);
+    }
+    return *this;
+}
+
+// Если опорный узел для нового отрезка не удалось сохранить, элемент удаляется и исключение передаётся дальше
+template <typename Type, typename Compare>
+typename SortedSingleLinkedList<Type, Compare>::ConstIterator SortedSingleLinkedList<Type, Compare>::InsertSorted(
+        const Type& value) {
+    const Position position = Locate([&](const Type& element) {return !comp_(value, element);});
+    const ConstIterator inserted = list_.InsertAfter(position.prev, value);
+    if (segments_.empty()) {
+        try {
+            segments_.push_back(Segment{inserted, 1});
+        } catch (...) {
+            list_.EraseAfter(position.prev);
+            throw;
+        }
+        return inserted;
+    }
+    Segment& segment = segments_[position.segment];
+    if (position.prev == list_.cbefore_begin()) {
+        segment.first = inserted;
+    }
+    ++segment.count;
+    SplitSegment(position.segment);
+    return inserted;
+}
+
+template <typename Type, typename Compare>
+[[nodiscard]] typename SortedSingleLinkedList<Type, Compare>::ConstIterator SortedSingleLinkedList<Type, Compare>::
+        LowerBound(const Type& value) const {
+    return std::next(Locate([&](const Type& element) {return comp_(element, value);}).prev);
+}
+
+template <typename Type, typename Compare>
+[[nodiscard]] typename SortedSingleLinkedList<Type, Compare>::ConstIterator SortedSingleLinkedList<Type, Compare>::
+        UpperBound(const Type& value) const {
+    return std::next(Locate([&](const Type& element) {return !comp_(value, element);}).prev);
+}
+
+template <typename Type, typename Compare>
+[[nodiscard]] typename SortedSingleLinkedList<Type, Compare>::ConstIterator SortedSingleLinkedList<Type, Compare>::
+        Find(const Type& value) const {
+    const ConstIterator it = LowerBound(value);
+    return it != end() && !comp_(value, *it) ? it : end();
+}
+
+// Равные элементы идут подряд после найденного узла. Удалённый узел мог быть первым в своём отрезке:
+// тогда отрезок начинается со следующего узла или, если опустел, удаляется
+template <typename Type, typename Compare>
+size_t SortedSingleLinkedList<Type, Compare>::EraseValue(const Type& value) {
+    const Position position = Locate([&](const Type& element) {return comp_(element, value);});
+    // Отрезок, в котором лежит position.prev; меняется, если этот отрезок слился с предыдущим
+    size_t prev_segment = position.segment;
+    size_t erased = 0;
+    for (ConstIterator next = std::next(position.prev); next != end() && !comp_(value, *next);
+         next = std::next(position.prev)) {
+        size_t index = prev_segment;
+        if (index + 1 < segments_.size() && segments_[index + 1].first == next) {
+            ++index;
+        }
+        Segment& segment = segments_[index];
+        if (segment.first == next) {
+            segment.first = std::next(next);
+        }
+        list_.EraseAfter(position.prev);
+        ++erased;
+        if (--segment.count == 0) {
+            segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(index));
+        } else if (const size_t merged = MergeSegment(index); index == prev_segment) {
+            prev_segment = merged;
+        }
+    }
+    return erased;
+}
+
+template <typename Type, typename Compare>
+void SortedSingleLinkedList<Type, Compare>::Clear() noexcept {
+    list_.Clear();
+    segments_.clear();
+}
+
+template <typename Type, typename Compare>
+void SortedSingleLinkedList<Type, Compare>::swap(SortedSingleLinkedList& other) noexcept {
+    list_.swap(other.list_);
+    segments_.swap(other.segments_);
+    std::swap(comp_, other.comp_);
+    RelocateSegments(other.list_);
+    other.RelocateSegments(list_);
+}
+
+// Позиция после всех элементов, для которых before(element) == true (before монотонен по порядку списка).
+// Двоичный поиск выбирает последний отрезок, чей первый элемент ещё "до" позиции; дальше проход внутри отрезка
+template <typename Type, typename Compare>
+template <typename Before>
+[[nodiscard]] typename SortedSingleLinkedList<Type, Compare>::Position SortedSingleLinkedList<Type, Compare>::Locate(
+        Before before) const {
+    const auto it = std::partition_point(segments_.begin(), segments_.end(), [&](const Segment& segment) {
+        return before(*segment.first);
+    });
+    if (it == segments_.begin()) {
+        return Position{0, list_.cbefore_begin()};
+    }
+    const size_t index = static_cast<size_t>(it - segments_.begin()) - 1;
+    ConstIterator prev = segments_[index].first;
+    for (size_t i = 1; i < segments_[index].count; ++i) {
+        const ConstIterator next = std::next(prev);
+        if (!before(*next)) {
+            break;
+        }
+        prev = next;
+    }
+    return Position{index, prev};
+}
+
+// Слишком длинный отрезок делится пополам. Если на новый опорный узел не хватило памяти,
+// отрезок остаётся длинным: поиск в нём медленнее, но правилен
+template <typename Type, typename Compare>
+void SortedSingleLinkedList<Type, Compare>::SplitSegment(size_t segment) noexcept {
+    Segment& current = segments_[segment];
+    if (current.count <= 2 * kSortedListSegment) {
+        return;
+    }
+    const size_t half = current.count / 2;
+    const Segment second{std::next(current.first, static_cast<std::ptrdiff_t>(half)), current.count - half};
+    try {
+        segments_.insert(segments_.begin() + static_cast<std::ptrdiff_t>(segment) + 1, second);
+        segments_[segment].count = half;
+    } catch (...) {
+    }
+}
+
+// Слишком короткий отрезок присоединяется к соседу, если вместе они не длиннее 2 * kSortedListSegment.
+// Возвращает номер отрезка, в котором оказались его элементы
+template <typename Type, typename Compare>
+[[nodiscard]] size_t SortedSingleLinkedList<Type, Compare>::MergeSegment(size_t segment) noexcept {
+    if (segments_[segment].count >= kSortedListSegment / 2) {
+        return segment;
+    }
+    if (segment + 1 < segments_.size()
+        && segments_[segment].count + segments_[segment + 1].count <= 2 * kSortedListSegment) {
+        segments_[segment].count += segments_[segment + 1].count;
+        segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(segment) + 1);
+    } else if (segment > 0
+               && segments_[segment - 1].count + segments_[segment].count <= 2 * kSortedListSegment) {
+        segments_[segment - 1].count += segments_[segment].count;
+        segments_.erase(segments_.begin() + static_cast<std::ptrdiff_t>(segment));
+        return segment - 1;
+    }
+    return segment;
+}
+
+// Опорные узлы через каждые kSortedListSegment элементов
+template <typename Type, typename Compare>
+void SortedSingleLinkedList<Type, Compare>::RebuildSegments() {
+    segments_.clear();
+    segments_.reserve((list_.GetSize() + kSortedListSegment - 1) / kSortedListSegment);
+    size_t index = 0;
+    for (ConstIterator it = list_.cbegin(); it != list_.cend(); ++it, ++index) {
+        if (index % kSortedListSegment == 0) {
+            segments_.push_back(Segment{it, 0});
+        }
+        ++segments_.back().count;
+    }
+}
+
+// Опорные узлы, перешедшие из встроенных ячеек списка from в те же ячейки list_ (см. ListInlineNodes)
+template <typename Type, typename Compare>
+void SortedSingleLinkedList<Type, Compare>::RelocateSegments(const SingleLinkedList<Type>& from) noexcept {
+    if constexpr (ListInlineNodes<Type>::value > 0) {
+        for (Segment& segment : segments_) {
+            segment.first = list_.Relocated(segment.first, from);
+        }
+    } else {
+        (void)from;
+    }
+}
+
+template <typename Type, typename Compare>
+void swap(SortedSingleLinkedList<Type, Compare>& lhs, SortedSingleLinkedList<Type, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
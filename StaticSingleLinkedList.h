@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace static_list_detail {
+
+// Самый узкий беззнаковый тип, в котором помещаются номера от 0 до MaxIndex
+template <size_t MaxIndex>
+using IndexFor = std::conditional_t<MaxIndex <= UINT8_MAX, std::uint8_t,
+                 std::conditional_t<MaxIndex <= UINT16_MAX, std::uint16_t,
+                 std::conditional_t<MaxIndex <= UINT32_MAX, std::uint32_t, std::uint64_t>>>;
+
+} // namespace static_list_detail
+
+// Односвязный список не больше чем на Capacity элементов, целиком лежащий внутри объекта: без кучи.
+// Узлы - ячейки встроенного массива, ссылки - номера ячеек самого узкого подходящего типа.
+// Освобождённые ячейки образуют список свободных, а ещё не выдававшиеся берутся по порядку, как в NodePool,
+// поэтому PushFront, PopFront, InsertAfter и EraseAfter выполняются за O(1) без обращений к распределителю памяти.
+// Вставка в заполненный список - исключение std::length_error; TryPushFront и TryInsertAfter вместо этого
+// сообщают о нехватке места результатом. Перемещение и обмен списков переносят элементы по одному за O(N)
+template <typename Type, size_t Capacity>
+class StaticSingleLinkedList {
+    static_assert(Capacity > 0, "StaticSingleLinkedList needs room for at least one element");
+
+    // Номер ячейки. Номер Capacity - фиктивный узел перед первым элементом, Capacity + 1 - конец списка
+    using Index = static_list_detail::IndexFor<Capacity + 1>;
+    static constexpr Index kHead = static_cast<Index>(Capacity);
+    static constexpr Index kNil = static_cast<Index>(Capacity + 1);
+
+    // Память под один элемент
+    struct alignas(Type) Storage {
+        unsigned char bytes[sizeof(Type)];
+    };
+
+    template <typename ValueType>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    using value_type = Type;
+    using reference = Type&;
+    using const_reference = const Type&;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    StaticSingleLinkedList() noexcept {next_[kHead] = kNil;}
+    StaticSingleLinkedList(std::initializer_list<Type> values);
+    template <typename InputIt>
+    StaticSingleLinkedList(InputIt first, InputIt last);
+    StaticSingleLinkedList(const StaticSingleLinkedList& other);
+    StaticSingleLinkedList(StaticSingleLinkedList&& other) noexcept(std::is_nothrow_move_constructible_v<Type>);
+    ~StaticSingleLinkedList();
+
+    // Присваивание даёт базовую гарантию: если копирование элемента выбросит исключение,
+    // в списке остаются уже скопированные элементы
+    StaticSingleLinkedList& operator=(const StaticSingleLinkedList& rhs);
+    StaticSingleLinkedList& operator=(StaticSingleLinkedList&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>);
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}
+    [[nodiscard]] bool IsEmpty() const noexcept {return size_ == 0;}
+    [[nodiscard]] bool IsFull() const noexcept {return size_ == Capacity;}
+    [[nodiscard]] static constexpr size_t GetCapacity() noexcept {return Capacity;}
+
+    void PushFront(const Type& value);                  // Вставка в начало; в заполненном списке - std::length_error
+    [[nodiscard]] bool TryPushFront(const Type& value); // Вставка в начало; false, если места нет
+    void PopFront() noexcept;                           // Удаляет первый элемент непустого списка
+    // Очищает список: O(N) разрушений элементов, O(1) для тривиально разрушаемых типов
+    void Clear() noexcept;
+    void swap(StaticSingleLinkedList& other) noexcept(std::is_nothrow_move_constructible_v<Type>);
+
+    // Вставка после pos; в заполненном списке - std::length_error
+    Iterator InsertAfter(ConstIterator pos, const Type& value);
+    // Вставка после pos; end(), если места нет
+    [[nodiscard]] Iterator TryInsertAfter(ConstIterator pos, const Type& value);
+    // Удаление элемента после pos. Возвращает итератор на следующий элемент
+    Iterator EraseAfter(ConstIterator pos) noexcept;
+
+    [[nodiscard]] Iterator begin() noexcept {return Iterator(this, next_[kHead]);}
+    [[nodiscard]] Iterator end() noexcept {return Iterator(this, kNil);}
+    [[nodiscard]] ConstIterator begin() const noexcept {return ConstIterator(this, next_[kHead]);}
+    [[nodiscard]] ConstIterator end() const noexcept {return ConstIterator(this, kNil);}
+    [[nodiscard]] ConstIterator cbegin() const noexcept {return begin();}
+    [[nodiscard]] ConstIterator cend() const noexcept {return end();}
+    [[nodiscard]] Iterator before_begin() noexcept {return Iterator(this, kHead);}
+    [[nodiscard]] ConstIterator before_begin() const noexcept {return ConstIterator(this, kHead);}
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {return before_begin();}
+
+private:
+    Storage values_[Capacity];
+    Index next_[Capacity + 1];              // next_[kHead] - первый элемент; у свободных ячеек - следующая свободная
+    Index free_ = kNil;                     // Первая освобождённая ячейка
+    Index used_ = 0;                        // Ячейки [0, used_) хотя бы раз выдавались
+    size_t size_ = 0;
+
+    [[nodiscard]] Type& ValueAt(Index index) noexcept {
+        return *std::launder(reinterpret_cast<Type*>(values_[index].bytes));
+    }
+    [[nodiscard]] const Type& ValueAt(Index index) const noexcept {
+        return *std::launder(reinterpret_cast<const Type*>(values_[index].bytes));
+    }
+
+    template <typename Value>
+    [[nodiscard]] Index Link(Index prev, Value&& value);
+    template <typename InputIt>
+    void Append(InputIt first, InputIt last);
+};
+
+// Итератор хранит список и номер ячейки: номера ячеек короче указателей, но сами по себе не адресуют память
+template <typename Type, size_t Capacity>
+template <typename ValueType>
+class StaticSingleLinkedList<Type, Capacity>::BasicIterator {
+    friend class StaticSingleLinkedList<Type, Capacity>;
+
+    using List = std::conditional_t<std::is_const_v<ValueType>, const StaticSingleLinkedList, StaticSingleLinkedList>;
+
+    BasicIterator(List* list, Index index) noexcept
+        : list_(list)
+        , index_(index) {
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    BasicIterator() = default;
+    // Неконстантный итератор преобразуется в константный
+    BasicIterator(const BasicIterator<Type>& other) noexcept
+        : list_(other.list_)
+        , index_(other.index_) {
+    }
+    BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+    [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
+        return index_ == rhs.index_ && list_ == rhs.list_;
+    }
+    [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {return !(*this == rhs);}
+
+    BasicIterator& operator++() noexcept {
+        assert(index_ != kNil);
+        index_ = list_->next_[index_];
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        auto old_value(*this);
+        ++(*this);
+        return old_value;
+    }
+
+    [[nodiscard]] reference operator*() const noexcept {
+        assert(index_ < Capacity);
+        return list_->ValueAt(index_);
+    }
+    [[nodiscard]] pointer operator->() const noexcept {return &**this;}
+
+private:
+    template <typename>
+    friend class BasicIterator;
+
+    List* list_ = nullptr;
+    Index index_ = kNil;
+};
+
+template <typename Type, size_t Capacity>
+StaticSingleLinkedList<Type, Capacity>::StaticSingleLinkedList(std::initializer_list<Type> values)
+    : StaticSingleLinkedList(values.begin(), values.end()) {
+}
+
+// Элементы сверх Capacity - исключение std::length_error
+template <typename Type, size_t Capacity>
+template <typename InputIt>
+StaticSingleLinkedList<Type, Capacity>::StaticSingleLinkedList(InputIt first, InputIt last)
+    : StaticSingleLinkedList() {
+    Append(first, last);
+}
+
+template <typename Type, size_t Capacity>
+StaticSingleLinkedList<Type, Capacity>::StaticSingleLinkedList(const StaticSingleLinkedList& other)
+    : StaticSingleLinkedList() {
+    Append(other.begin(), other.end());
+}
+
+// Элементы переносятся по порядку в ячейки 0, 1, ...; other остаётся пустым
+template <typename Type, size_t Capacity>
+StaticSingleLinkedList<Type, Capacity>::StaticSingleLinkedList(StaticSingleLinkedList&& other) noexcept(
+        std::is_nothrow_move_constructible_v<Type>)
+    : StaticSingleLinkedList() {
+    Append(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    other.Clear();
+}
+
+template <typename Type, size_t Capacity>
+StaticSingleLinkedList<Type, Capacity>::~StaticSingleLinkedList() {
+    Clear();
+}
+
+template <typename Type, size_t Capacity>
+StaticSingleLinkedList<Type, Capacity>& StaticSingleLinkedList<Type, Capacity>::operator=(
+        const StaticSingleLinkedList& rhs) {
+    if (this != &rhs) {
+        Clear();
+        Append(rhs.begin(), rhs.end());
+    }
+    return *this;
+}
+
+template <typename Type, size_t Capacity>
+StaticSingleLinkedList<Type, Capacity>& StaticSingleLinkedList<Type, Capacity>::operator=(
+        StaticSingleLinkedList&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+    if (this != &rhs) {
+        Clear();
+        Append(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+        rhs.Clear();
+    }
+    return *this;
+}
+
+template <typename Type, size_t Capacity>
+void StaticSingleLinkedList<Type, Capacity>::PushFront(const Type& value) {
+    InsertAfter(cbefore_begin(), value);
+}
+
+template <typename Type, size_t Capacity>
+[[nodiscard]] bool StaticSingleLinkedList<Type, Capacity>::TryPushFront(const Type& value) {
+    return TryInsertAfter(cbefore_begin(), value) != end();
+}
+
+template <typename Type, size_t Capacity>
+void StaticSingleLinkedList<Type, Capacity>::PopFront() noexcept {
+    assert(!IsEmpty());
+    EraseAfter(cbefore_begin());
+}
+
+// Ячейки не перебираются по одной: счётчик выданных ячеек и список свободных просто сбрасываются
+template <typename Type, size_t Capacity>
+void StaticSingleLinkedList<Type, Capacity>::Clear() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<Type>) {
+        for (Index index = next_[kHead]; index != kNil; index = next_[index]) {
+            ValueAt(index).~Type();
+        }
+    }
+    next_[kHead] = kNil;
+    free_ = kNil;
+    used_ = 0;
+    size_ = 0;
+}
+
+// Элементы лежат внутри объектов, поэтому обмен - три переноса элементов через временный список
+template <typename Type, size_t Capacity>
+void StaticSingleLinkedList<Type, Capacity>::swap(StaticSingleLinkedList& other) noexcept(
+        std::is_nothrow_move_constructible_v<Type>) {
+    if (this != &other) {
+        StaticSingleLinkedList tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+}
+
+template <typename Type, size_t Capacity>
+typename StaticSingleLinkedList<Type, Capacity>::Iterator StaticSingleLinkedList<Type, Capacity>::InsertAfter(
+        ConstIterator pos, const Type& value) {
+    if (IsFull()) {
+        throw std::length_error("StaticSingleLinkedList capacity exceeded");
+    }
+    return Iterator(this, Link(pos.index_, value));
+}
+
+template <typename Type, size_t Capacity>
+[[nodiscard]] typename StaticSingleLinkedList<Type, Capacity>::Iterator StaticSingleLinkedList<Type, Capacity>::
+        TryInsertAfter(ConstIterator pos, const Type& value) {
+    return IsFull() ? end() : Iterator(this, Link(pos.index_, value));
+}
+
+// Освобождённая ячейка становится первой в списке свободных
+template <typename Type, size_t Capacity>
+typename StaticSingleLinkedList<Type, Capacity>::Iterator StaticSingleLinkedList<Type, Capacity>::EraseAfter(
+        ConstIterator pos) noexcept {
+    assert(pos.list_ == this && pos.index_ != kNil && next_[pos.index_] != kNil);
+    const Index erased = next_[pos.index_];
+    next_[pos.index_] = next_[erased];
+    ValueAt(erased).~Type();
+    next_[erased] = free_;
+    free_ = erased;
+    --size_;
+    return Iterator(this, next_[pos.index_]);
+}
+
+// Занимает ячейку (сначала из освобождённых) и вставляет элемент после prev. Место должно быть.
+// Элемент копируется из lvalue и перемещается из rvalue (перемещение и обмен списков не копируют).
+// Если конструктор элемента выбросит исключение, ячейка остаётся свободной
+template <typename Type, size_t Capacity>
+template <typename Value>
+[[nodiscard]] typename StaticSingleLinkedList<Type, Capacity>::Index StaticSingleLinkedList<Type, Capacity>::Link(
+        Index prev, Value&& value) {
+    assert(prev != kNil && !IsFull());
+    const Index index = free_ != kNil ? free_ : used_;
+    new (values_[index].bytes) Type(std::forward<Value>(value));
+    if (index == free_) {
+        free_ = next_[index];
+    } else {
+        ++used_;
+    }
+    next_[index] = next_[prev];
+    next_[prev] = index;
+    ++size_;
+    return index;
+}
+
+// Дописывает элементы в конец списка. Если копирование выбросит исключение или место кончится, список очищается
+template <typename Type, size_t Capacity>
+template <typename InputIt>
+void StaticSingleLinkedList<Type, Capacity>::Append(InputIt first, InputIt last) {
+    Index tail = kHead;
+    while (next_[tail] != kNil) {
+        tail = next_[tail];
+    }
+    try {
+        for (; first != last; ++first) {
+            if (IsFull()) {
+                throw std::length_error("StaticSingleLinkedList capacity exceeded");
+            }
+            tail = Link(tail, *first);
+        }
+    } catch (...) {
+        Clear();
+        throw;
+    }
+}
+
+template <typename Type, size_t Capacity>
+void swap(StaticSingleLinkedList<Type, Capacity>& lhs, StaticSingleLinkedList<Type, Capacity>& rhs) noexcept(
+        std::is_nothrow_move_constructible_v<Type>) {
+    lhs.swap(rhs);
+}
+
+template <typename Type, size_t Capacity>
+bool operator==(const StaticSingleLinkedList<Type, Capacity>& lhs, const StaticSingleLinkedList<Type, Capacity>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t Capacity>
+bool operator!=(const StaticSingleLinkedList<Type, Capacity>& lhs, const StaticSingleLinkedList<Type, Capacity>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t Capacity>
+bool operator<(const StaticSingleLinkedList<Type, Capacity>& lhs, const StaticSingleLinkedList<Type, Capacity>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t Capacity>
+bool operator<=(const StaticSingleLinkedList<Type, Capacity>& lhs, const StaticSingleLinkedList<Type, Capacity>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t Capacity>
+bool operator>(const StaticSingleLinkedList<Type, Capacity>& lhs, const StaticSingleLinkedList<Type, Capacity>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t Capacity>
+bool operator>=(const StaticSingleLinkedList<Type, Capacity>& lhs, const StaticSingleLinkedList<Type, Capacity>& rhs) {
+    return !(lhs < rhs);
+}
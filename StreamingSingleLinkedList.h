@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "SingleLinkedList.h"
+
+// Размер части по умолчанию: столько элементов ListStreamReader держит в памяти одновременно
+inline constexpr size_t kDefaultStreamChunkSize = 4096;
+
+// Потоковое чтение списка, записанного SingleLinkedList::Serialize, частями не больше chunk_size элементов.
+// Весь список в памяти не собирается: ReadChunk отдаёт очередную часть отдельным списком,
+// ForEach передаёт значения в функцию по одному. Если список всё-таки нужен целиком,
+// AppendChunk дописывает части в его конец по хвостовому итератору, не обходя уже прочитанное.
+// Заголовок проверяется в конструкторе; ошибки данных - исключение std::runtime_error
+template <typename Type>
+class ListStreamReader {
+public:
+    using ConstIterator = typename SingleLinkedList<Type>::ConstIterator;
+
+    explicit ListStreamReader(ListByteReader& reader, size_t chunk_size = kDefaultStreamChunkSize);
+    explicit ListStreamReader(std::istream& in, size_t chunk_size = kDefaultStreamChunkSize);
+    ListStreamReader(const ListStreamReader&) = delete;
+    ListStreamReader& operator=(const ListStreamReader&) = delete;
+
+    [[nodiscard]] size_t GetSize() const noexcept {return size_;}           // Количество элементов из заголовка
+    [[nodiscard]] size_t GetRemaining() const noexcept {return remaining_;} // Сколько ещё не прочитано
+    [[nodiscard]] bool IsDone() const noexcept {return remaining_ == 0;}
+
+    // Следующая часть списка (пустой список, если всё прочитано). Узлы части лежат в одном слабе
+    [[nodiscard]] SingleLinkedList<Type> ReadChunk();
+
+    // Переносит следующую часть в list после pos и возвращает итератор на последний перенесённый элемент
+    // (pos, если читать было нечего). Возвращённый итератор - позиция для следующего вызова
+    ConstIterator AppendChunk(SingleLinkedList<Type>& list, ConstIterator pos);
+
+    // Передаёт все оставшиеся значения в f(Type&&), не создавая узлов.
+    // Побайтовые значения читаются блоками по chunk_size элементов
+    template <typename F>
+    void ForEach(F&& f);
+
+private:
+    std::optional<ListByteReader> own_reader_;
+    ListByteReader* reader_ = nullptr;
+    size_t chunk_size_ = kDefaultStreamChunkSize;
+    size_t size_ = 0;
+    size_t remaining_ = 0;
+};
+
+template <typename Type>
+ListStreamReader<Type>::ListStreamReader(ListByteReader& reader, size_t chunk_size)
+    : reader_(&reader)
+    , chunk_size_(std::max<size_t>(chunk_size, 1))
+    , size_(SingleLinkedList<Type>::ReadSerializationHeader(reader))
+    , remaining_(size_) {
+}
+
+template <typename Type>
+ListStreamReader<Type>::ListStreamReader(std::istream& in, size_t chunk_size)
+    : own_reader_(std::in_place, in)
+    , reader_(&*own_reader_)
+    , chunk_size_(std::max<size_t>(chunk_size, 1))
+    , size_(SingleLinkedList<Type>::ReadSerializationHeader(*reader_))
+    , remaining_(size_) {
+}
+
+template <typename Type>
+[[nodiscard]] SingleLinkedList<Type> ListStreamReader<Type>::ReadChunk() {
+    const size_t count = std::min(remaining_, chunk_size_);
+    auto chunk = SingleLinkedList<Type>::ReadSerializedValues(*reader_, count);
+    remaining_ -= count;
+    return chunk;
+}
+
+template <typename Type>
+typename ListStreamReader<Type>::ConstIterator ListStreamReader<Type>::AppendChunk(SingleLinkedList<Type>& list,
+                                                                                 ConstIterator pos) {
+    const size_t count = std::min(remaining_, chunk_size_);
+    if (count == 0) {
+        return pos;
+    }
+    ConstIterator last;
+    auto chunk = SingleLinkedList<Type>::ReadSerializedValues(*reader_, count, &last);
+    remaining_ -= count;
+    list.SpliceAfter(pos, chunk, last);
+    return last;
+}
+
+template <typename Type>
+template <typename F>
+void ListStreamReader<Type>::ForEach(F&& f) {
+    using Codec = ListValueCodec<Type>;
+    if constexpr (Codec::kBitwise) {
+        std::vector<char> chunk(std::min(remaining_, chunk_size_) * sizeof(Type));
+        while (remaining_ > 0) {
+            const size_t count = std::min(remaining_, chunk_size_);
+            const char* values = reader_->View(count * sizeof(Type));
+            if (values == nullptr) {
+                reader_->Read(chunk.data(), count * sizeof(Type));
+                values = chunk.data();
+            }
+            for (size_t i = 0; i < count; ++i, values += sizeof(Type)) {
+                Type value;
+                std::memcpy(&value, values, sizeof(Type));
+                --remaining_;
+                f(std::move(value));
+            }
+        }
+    } else {
+        for (; remaining_ > 0; --remaining_) {
+            f(Codec::Decode(*reader_));
+        }
+    }
+}
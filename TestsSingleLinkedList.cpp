@@ -1,17 +1,169 @@
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include "TestsSingleLinkedList.h"
 
+// Тип элементов, для списков которого включён сбор статистики выделений
+struct StatsProbe {
+    int value = 0;
+};
+
+template <>
+struct EnableListStats<StatsProbe> : std::true_type {};
+
+// Счётчики обращений к куче проверяются и при SINGLE_LINKED_LIST_INLINE_NODES, поэтому ячеек у StatsProbe нет
+template <>
+struct ListInlineNodes<StatsProbe> : std::integral_constant<size_t, 0> {};
+
+// Списки с кэшем хэша: целые (хэш по байтам) и строки (через std::hash)
+template <>
+struct EnableListHashCache<unsigned> : std::true_type {};
+
+template <>
+struct EnableListHashCache<std::string> : std::true_type {};
+
+// Списки long с индексом позиций
+template <>
+struct EnableListPositionIndex<long> : std::true_type {};
+
+// Списки со встроенными узлами. Строка держит память в куче, чтобы санитайзер заметил обращение
+// к ячейке после переноса её элемента, а статистика показывает, обращался ли список к куче
+struct InlineProbe {
+    std::string text;
+
+    bool operator==(const InlineProbe& rhs) const {
+        return text == rhs.text;
+    }
+    bool operator<(const InlineProbe& rhs) const {
+        return text < rhs.text;
+    }
+};
+
+struct InlineProbeHash {
+    size_t operator()(const InlineProbe& probe) const {
+        return std::hash<std::string>()(probe.text);
+    }
+};
+
+template <>
+struct EnableListStats<InlineProbe> : std::true_type {};
+
+template <>
+struct ListInlineNodes<InlineProbe> : std::integral_constant<size_t, 4> {};
+
+// Тривиальные значения: short - со встроенными узлами, OpaqueBytes - с выключенным побайтовым путём
+template <>
+struct ListInlineNodes<short> : std::integral_constant<size_t, 4> {};
+
+struct OpaqueBytes {
+    int value = 0;
+};
+
+template <>
+struct ListTrivialValues<OpaqueBytes> : std::false_type {};
+
+// Значение со своим кодеком; Decode выбрасывает исключение на отрицательном числе
+struct Tagged {
+    int value = 0;
+    std::string tag;
+
+    bool operator==(const Tagged& rhs) const {
+        return value == rhs.value && tag == rhs.tag;
+    }
+};
+
+template <>
+struct ListValueCodec<Tagged> {
+    static constexpr bool kBitwise = false;
+
+    static void Encode(const Tagged& item, ListByteWriter& writer) {
+        writer.WriteValue(item.value);
+        ListValueCodec<std::string>::Encode(item.tag, writer);
+    }
+
+    static Tagged Decode(ListByteReader& reader) {
+        Tagged item;
+        item.value = reader.ReadValue<int>();
+        if (item.value < 0) {
+            throw std::invalid_argument("negative value");
+        }
+        item.tag = ListValueCodec<std::string>::Decode(reader);
+        return item;
+    }
+};
+
 void Test1();
 void Test2();
 void Test3();
 void Test4();
+void Test5();
+void Test6();
+void Test7();
+void Test8();
+void Test9();
+void Test10();
+void Test11();
+void Test12();
+void Test13();
+void Test14();
+void Test15();
+void Test16();
+void Test17();
+void Test18();
+void Test19();
+void Test20();
+void Test21();
+void Test22();
+void Test23();
+void Test24();
+void Test25();
+void Test26();
 
 void RunTests() {
     Test1();
     Test2();
     Test3();
     Test4();
+    Test5();
+    Test6();
+    Test7();
+    Test8();
+    Test9();
+    Test10();
+    Test11();
+    Test12();
+    Test13();
+    Test14();
+    Test15();
+    Test16();
+    Test17();
+    Test18();
+    Test19();
+    Test20();
+    Test21();
+    Test22();
+    Test23();
+    Test24();
+    Test25();
+    Test26();
 }
 
 void Test1() {
@@ -280,8 +432,11 @@ void Test3() {
 
         first.swap(second);
 
-        assert(second.begin() == old_first_begin);
-        assert(first.begin() == old_second_begin);
+        // Элементы встроенных ячеек (см. ListInlineNodes) при обмене переезжают, и итераторы на них меняются
+        if constexpr (ListInlineNodes<int>::value == 0) {
+            assert(second.begin() == old_first_begin);
+            assert(first.begin() == old_second_begin);
+        }
         assert(second.GetSize() == old_first_size);
         assert(first.GetSize() == old_second_size);
 
@@ -556,3 +711,2306 @@ void Test4() {
         }
     }
 }
+
+void Test5() {
+    // Сращивание списков
+    {
+        SingleLinkedList<int> lst{1, 4};
+        SingleLinkedList<int> other{2, 3};
+        const auto other_begin = other.cbegin();
+        lst.SpliceAfter(lst.cbegin(), other, ++other.cbegin());
+        assert((lst == SingleLinkedList<int>{1, 2, 3, 4}));
+        assert(lst.GetSize() == 4u);
+        assert(other.IsEmpty());
+        if constexpr (ListInlineNodes<int>::value == 0) {
+            assert(++lst.cbegin() == other_begin);
+        }
+    }
+
+    // Перемещение списков
+    {
+        SingleLinkedList<int> source{1, 2, 3};
+        const auto old_begin = source.begin();
+        SingleLinkedList<int> moved(std::move(source));
+        assert(moved.begin() == moved.Relocated(old_begin, source));
+        if constexpr (ListInlineNodes<int>::value == 0) {
+            assert(moved.begin() == old_begin);
+        }
+        assert(moved.GetSize() == 3u);
+        assert(source.IsEmpty());
+
+        SingleLinkedList<int> receiver{7};
+        receiver = std::move(moved);
+        if constexpr (ListInlineNodes<int>::value == 0) {
+            assert(receiver.begin() == old_begin);
+        }
+        assert((receiver == SingleLinkedList<int>{1, 2, 3}));
+    }
+
+    // Шардированный список: вставка из нескольких потоков, обход и Drain
+    {
+        ShardedSingleLinkedList<int, 4> sharded;
+        assert(sharded.IsEmpty());
+        assert(sharded.begin() == sharded.end());
+
+        const int threads_count = 4;
+        const int values_per_thread = 1000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&sharded, t] {
+                for (int i = 0; i < values_per_thread; ++i) {
+                    sharded.PushFront(t * values_per_thread + i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        sharded.PushFront(-1, 3u);
+
+        const size_t total = threads_count * values_per_thread + 1;
+        assert(sharded.GetSize() == total);
+        assert(static_cast<size_t>(std::distance(sharded.begin(), sharded.end())) == total);
+
+        long long expected_sum = -1;
+        for (int v = 0; v < threads_count * values_per_thread; ++v) {
+            expected_sum += v;
+        }
+        long long sum = 0;
+        for (int value : sharded) {
+            sum += value;
+        }
+        assert(sum == expected_sum);
+
+        // Drain сохраняет порядок обхода
+        const std::vector<int> merged(sharded.begin(), sharded.end());
+        SingleLinkedList<int> drained = sharded.Drain();
+        assert(sharded.IsEmpty());
+        assert(drained.GetSize() == total);
+        assert(std::equal(drained.begin(), drained.end(), merged.begin(), merged.end()));
+
+        // После Drain шарды снова принимают элементы
+        sharded.PushFront(42);
+        assert(sharded.GetSize() == 1u);
+        assert(*sharded.begin() == 42);
+        sharded.Clear();
+        assert(sharded.IsEmpty());
+    }
+}
+
+void Test6() {
+    // Индекс разбиения
+    {
+        SingleLinkedList<int> list{1, 2, 3, 4, 5, 6, 7};
+        SplitIndex index(list.cbegin(), list.cend(), 3);
+        assert(index.GetChunkCount() == 3u);
+        assert(index.GetElementCount() == 7u);
+        assert(*index.ChunkBegin(1) == 4);
+        assert(index.ChunkEnd(2) == list.cend());
+
+        SingleLinkedList<int> empty;
+        SplitIndex empty_index(empty.cbegin(), empty.cend(), 3);
+        assert(empty_index.GetChunkCount() == 0u);
+    }
+
+    // Параллельные алгоритмы дают тот же результат, что и последовательные
+    {
+        ParallelExecutor executor(3);
+        assert(executor.GetThreadCount() == 3u);
+
+        SingleLinkedList<int> list;
+        for (int i = 0; i < 10000; ++i) {
+            list.PushFront(i);
+        }
+
+        ParallelForEach(list, [](int& value) { value *= 2; }, executor);
+        const long long sum = ParallelReduce(list, 0LL, [](long long acc, long long value) { return acc + value; },
+                                             executor);
+        assert(sum == 2LL * (9999LL * 10000 / 2));
+
+        const size_t divisible_by_4 = ParallelCount(list, [](int value) { return value % 4 == 0; }, executor);
+        assert(divisible_by_4 == 5000u);
+
+        // Повторное использование готового индекса
+        const auto& const_list = list;
+        SplitIndex index(const_list.begin(), const_list.end(), 128);
+        assert(ParallelCount(index, [](int value) { return value < 0; }, executor) == 0u);
+        SplitIndex mutable_index(list.begin(), list.end(), 1000);
+        ParallelForEach(mutable_index, [](int& value) { value /= 2; }, executor);
+        assert(ParallelCount(mutable_index, [](int value) { return value == 9999; }, executor) == 1u);
+
+        // Порядок объединения частичных результатов сохраняется
+        SingleLinkedList<std::string> words{"a", "b", "c", "d", "e"};
+        using namespace std::string_literals;
+        SplitIndex words_index(words.cbegin(), words.cend(), 2);
+        assert(ParallelReduce(words_index, ">"s, std::plus<std::string>{}, executor) == ">abcde"s);
+
+        // Накопителю не нужен конструктор по умолчанию
+        struct Total {
+            Total(int value) : sum(value) {}
+            long long sum;
+        };
+        struct AddTotal {
+            Total operator()(Total acc, int value) const {
+                acc.sum += value;
+                return acc;
+            }
+            Total operator()(Total lhs, Total rhs) const {
+                lhs.sum += rhs.sum;
+                return lhs;
+            }
+        };
+        static_assert(!std::is_default_constructible_v<Total>);
+        assert(ParallelReduce(index, Total(1), AddTotal{}, executor).sum == 1 + 9999LL * 10000 / 2);
+
+        // Исключение из задачи передаётся вызывающему
+        bool exception_was_thrown = false;
+        try {
+            ParallelForEach(list, [](int value) {
+                if (value == 42) {
+                    throw std::runtime_error("42");
+                }
+            }, executor);
+        } catch (const std::runtime_error&) {
+            exception_was_thrown = true;
+        }
+        assert(exception_was_thrown);
+
+        SingleLinkedList<int> empty;
+        assert(ParallelReduce(empty, 5, std::plus<int>{}, executor) == 5);
+    }
+}
+
+void Test7() {
+    // Обход с предвыборкой посещает все элементы по порядку при любом опережении
+    {
+        SingleLinkedList<int> list{1, 2, 3, 4, 5};
+        for (size_t distance : {0u, 1u, 4u, 5u, 100u}) {
+            std::vector<int> visited;
+            ForEachPrefetched(list, [&visited](int value) { visited.push_back(value); }, distance);
+            assert((visited == std::vector<int>{1, 2, 3, 4, 5}));
+        }
+
+        ForEachPrefetched(list, [](int& value) { value *= 10; });
+        assert((list == SingleLinkedList<int>{10, 20, 30, 40, 50}));
+
+        SingleLinkedList<int> empty;
+        int calls = 0;
+        ForEachPrefetched(empty, [&calls](int) { ++calls; });
+        assert(calls == 0);
+    }
+
+    // Предвыбирающий итератор совместим с алгоритмами стандартной библиотеки
+    {
+        using namespace std::string_literals;
+        const SingleLinkedList<std::string> list{"a"s, "bb"s, "ccc"s};
+        auto [first, last] = MakePrefetchingRange(list.begin(), list.end(), 2);
+        assert(std::distance(first, last) == 3);
+        assert(first->length() == 1u);
+        assert(std::find(first, last, "bb"s).base() == ++list.begin());
+        assert((first++).base() == list.begin());
+        assert(*first == "bb"s);
+    }
+
+    // Пакетный поиск в нескольких списках
+    {
+        SingleLinkedList<int> a{1, 2, 3};
+        SingleLinkedList<int> b{3, 3};
+        SingleLinkedList<int> c;
+        SingleLinkedList<int> d{4, 5};
+        std::vector<SingleLinkedList<int>*> lists{&a, &b, &c, &d, &a};
+
+        for (size_t group : {0u, 1u, 2u, 16u}) {
+            const auto found = FindInEach(lists, 3, group);
+            assert(found.size() == lists.size());
+            assert(found[0] == ++(++a.cbegin()));
+            assert(found[1] == b.cbegin());
+            assert(found[2] == c.cend());
+            assert(found[3] == d.cend());
+            assert(found[4] == found[0]);
+        }
+
+        std::vector<const SingleLinkedList<int>*> none;
+        assert(FindInEach(none, 1).empty());
+    }
+}
+
+void Test8() {
+    // Адрес элемента i-го узла относительно первого: в уплотнённом списке узлы идут с шагом в один узел
+    const auto is_contiguous = [](const auto& list) {
+        const auto* first = &*list.begin();
+        const auto* prev = first;
+        for (auto it = ++list.begin(); it != list.end(); ++it) {
+            const auto* current = &*it;
+            if (reinterpret_cast<const char*>(current) - reinterpret_cast<const char*>(prev)
+                != reinterpret_cast<const char*>(&*++list.begin()) - reinterpret_cast<const char*>(first)) {
+                return false;
+            }
+            prev = current;
+        }
+        return true;
+    };
+
+    // Полное уплотнение
+    {
+        SingleLinkedList<int> list;
+        std::vector<SingleLinkedList<int>::Iterator> positions{list.before_begin()};
+        for (int i = 0; i < 100; ++i) {
+            positions.push_back(list.InsertAfter(positions[(i * 37) % positions.size()], i));
+        }
+        const std::vector<int> expected(list.begin(), list.end());
+
+        const auto result = list.Compact();
+        assert(result.finished);
+        assert(result.nodes_relocated == 100u);
+        assert(result.bytes_allocated > 0u);
+        assert(result.bytes_released > 0u);
+        assert(list.GetSize() == 100u);
+        assert(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+        assert(is_contiguous(list));
+
+        // Повторное уплотнение уже уплотнённого списка ничего не переносит
+        const auto second = list.Compact();
+        assert(second.nodes_relocated == 0u);
+        assert(second.GetBytesReclaimed() == 0);
+
+        // Уплотнённый список поддерживает обычные операции
+        list.EraseAfter(list.cbegin());
+        list.PushFront(-1);
+        list.InsertAfter(list.cbegin(), -2);
+        assert(list.GetSize() == 101u);
+        assert(*list.begin() == -1 && *++list.begin() == -2);
+        auto copy(list);
+        assert(copy == list);
+
+        // Слабы переходят вместе с узлами при сращивании
+        SingleLinkedList<int> receiver{1000};
+        auto last = list.cbegin();
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            last = it;
+        }
+        receiver.SpliceAfter(receiver.cbegin(), list, last);
+        assert(list.IsEmpty());
+        assert(receiver.GetSize() == 102u);
+        list.PushFront(1);
+        receiver.Clear();
+        assert(receiver.IsEmpty());
+    }
+
+    // Пошаговое уплотнение
+    {
+        SingleLinkedList<std::string> list;
+        for (int i = 0; i < 10; ++i) {
+            list.PushFront(std::to_string(i));
+        }
+        const std::vector<std::string> expected(list.begin(), list.end());
+        size_t steps = 0;
+        size_t relocated = 0;
+        for (bool finished = false; !finished; ++steps) {
+            const auto result = list.CompactStep(3);
+            relocated += result.nodes_relocated;
+            finished = result.finished;
+        }
+        assert(steps == 4u);
+        assert(relocated == 10u);
+        assert(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+
+        // Удаление узла, на котором остановилось уплотнение, перезапускает его с начала
+        list.CompactStep(2);
+        list.PopFront();
+        list.EraseAfter(list.cbefore_begin());
+        assert(list.CompactStep(100).finished);
+        assert(list.GetSize() == 8u);
+        assert(is_contiguous(list));
+    }
+
+    // Исключение при переносе значения оставляет список целым
+    {
+        struct ThrowOnCopy {
+            ThrowOnCopy() = default;
+            ThrowOnCopy(const ThrowOnCopy& other)
+                : countdown_ptr(other.countdown_ptr) {
+                if (countdown_ptr) {
+                    if (*countdown_ptr == 0) {
+                        throw std::bad_alloc();
+                    }
+                    --(*countdown_ptr);
+                }
+            }
+            ThrowOnCopy& operator=(const ThrowOnCopy& rhs) = delete;
+            int* countdown_ptr = nullptr;
+        };
+
+        SingleLinkedList<ThrowOnCopy> list{ThrowOnCopy{}, ThrowOnCopy{}, ThrowOnCopy{}, ThrowOnCopy{}};
+        int copy_counter = 2;
+        for (auto& item : list) {
+            item.countdown_ptr = &copy_counter;
+        }
+        bool exception_was_thrown = false;
+        try {
+            list.Compact();
+        } catch (const std::bad_alloc&) {
+            exception_was_thrown = true;
+        }
+        assert(exception_was_thrown);
+        assert(list.GetSize() == 4u);
+        assert(std::distance(list.begin(), list.end()) == 4);
+        for (auto& item : list) {
+            item.countdown_ptr = nullptr;
+        }
+        assert(list.Compact().finished);
+    }
+}
+
+void Test9() {
+    using ProbeList = SingleLinkedList<StatsProbe>;
+    ListStatsRegistry<StatsProbe>::Reset();
+
+    // Без включения статистика не собирается
+    if constexpr (!EnableListStats<int>::value) {
+        SingleLinkedList<int> list{1, 2, 3};
+        assert(SingleLinkedList<int>::GetStats().nodes_created == 0u);
+    }
+
+    {
+        ProbeList list;
+        list.PushFront(StatsProbe{1});
+        list.PushFront(StatsProbe{2});
+        list.InsertAfter(list.cbegin(), StatsProbe{3});
+        ListStats stats = ProbeList::GetStats();
+        assert(stats.heap_allocations == 3u);
+        assert(stats.nodes_created == 3u);
+        assert(stats.value_copies == 3u);
+        assert(stats.live_nodes == 3u);
+        assert(stats.bytes_outstanding > 0u);
+        const size_t bytes_per_node = stats.bytes_outstanding / 3;
+
+        {
+            ProbeList copy(list);
+            stats = ProbeList::GetStats();
+            assert(stats.value_copies == 6u);
+            assert(stats.peak_nodes == 6u);
+        }
+        stats = ProbeList::GetStats();
+        assert(stats.live_nodes == 3u);
+        assert(stats.heap_frees == 3u);
+        assert(stats.bytes_outstanding == 3 * bytes_per_node);
+
+        // Перемещение и обмен не выделяют память и не копируют значения
+        ProbeList moved(std::move(list));
+        moved.swap(list);
+        assert(ProbeList::GetStats().heap_allocations == 6u);
+
+        // Уплотнение: одно выделение под слаб вместо трёх отдельных узлов
+        list.Compact();
+        stats = ProbeList::GetStats();
+        assert(stats.heap_allocations == 7u);
+        assert(stats.heap_frees == 6u);
+        assert(stats.live_nodes == 3u);
+        assert(stats.value_copies == 6u);
+
+        list.PopFront();
+        list.Clear();
+        stats = ProbeList::GetStats();
+        assert(stats.live_nodes == 0u);
+        assert(stats.nodes_destroyed == stats.nodes_created);
+        assert(stats.heap_frees == 7u);
+        assert(stats.bytes_outstanding == 0u);
+        assert(stats.peak_nodes == 6u);
+    }
+
+    // Уплотнение по одному узлу: шаги продолжают хвост слаба, а слабы растут вдвое,
+    // поэтому слабов O(log N), а не по одному на шаг
+    {
+        ProbeList list;
+        for (int i = 0; i < 10000; ++i) {
+            list.PushFront(StatsProbe{i});
+        }
+        const ListStats before = ProbeList::GetStats();
+        size_t steps = 0;
+        while (!list.CompactStep(1).finished) {
+            ++steps;
+        }
+        assert(steps + 1 == 10000u);
+        ListStats stats = ProbeList::GetStats();
+        const size_t slabs = stats.heap_allocations - before.heap_allocations;
+        assert(slabs <= 10u);
+        assert(list.MemoryUsage().pooled_nodes == 10000u);
+
+        // Узлы идут подряд с шагом в один узел везде, кроме границ слабов
+        const auto address = [](const StatsProbe& value) {
+            return reinterpret_cast<std::uintptr_t>(&value);
+        };
+        const std::uintptr_t stride = address(*std::next(list.begin())) - address(*list.begin());
+        size_t breaks = 0;
+        for (auto it = list.begin(), next = std::next(it); next != list.end(); ++it, ++next) {
+            breaks += address(*next) - address(*it) != stride;
+        }
+        assert(breaks < slabs);
+
+        // Шаги покрупнее сливаются со свободным хвостом так же
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(StatsProbe{-i});
+        }
+        const size_t allocations = ProbeList::GetStats().heap_allocations;
+        while (!list.CompactStep(64).finished) {
+        }
+        assert(ProbeList::GetStats().heap_allocations - allocations <= 2u);
+
+        list.Clear();
+        stats = ProbeList::GetStats();
+        assert(stats.live_nodes == 0u && stats.bytes_outstanding == 0u);
+    }
+
+    ListStatsRegistry<StatsProbe>::Reset();
+    const ListStats stats = ProbeList::GetStats();
+    assert(stats.heap_allocations == 0u && stats.peak_nodes == 0u);
+}
+
+void Test10() {
+    // Пустой список занимает только сам объект
+    {
+        const SingleLinkedList<int> list;
+        const ListMemoryUsage usage = list.MemoryUsage();
+        assert(usage.node_count == 0u && usage.node_bytes == 0u && usage.allocator_overhead == 0u);
+        assert(usage.GetTotalBytes() == sizeof(list));
+        assert(usage.GetBytesPerElement() == 0.0);
+    }
+
+    // Узлы в куче: размер узла, выравнивание и служебные данные malloc.
+    // Со встроенными ячейками (см. ListInlineNodes) эти узлы не попали бы в кучу
+    if constexpr (ListInlineNodes<char>::value == 0) {
+        SingleLinkedList<char> list{'a', 'b', 'c', 'd'};
+        const ListMemoryUsage usage = list.MemoryUsage();
+        assert(usage.node_count == 4u && usage.heap_nodes == 4u && usage.pooled_nodes == 0u);
+        assert(usage.node_size == sizeof(char) + usage.node_padding + sizeof(void*));
+        assert(usage.node_padding == alignof(void*) - 1);
+        assert(usage.node_bytes == 4 * usage.node_size);
+        assert(usage.allocator_overhead == 4 * (EstimateMallocChunkSize(usage.node_size) - usage.node_size));
+        assert(usage.value_heap_bytes == 0u);
+
+        // После уплотнения узлы лежат в слабе и служебные данные malloc приходятся на весь слаб
+        list.Compact();
+        const ListMemoryUsage compact = list.MemoryUsage();
+        assert(compact.pooled_nodes == 4u && compact.heap_nodes == 0u);
+        assert(compact.node_bytes == usage.node_bytes);
+        assert(compact.allocator_overhead < usage.allocator_overhead);
+        list.PopFront();
+        // Освободившаяся ячейка слаба учитывается как накладные расходы
+        assert(list.MemoryUsage().allocator_overhead > compact.allocator_overhead);
+    }
+
+    // Память, которой владеют сами значения
+    {
+        const std::string long_value(100, 'x');
+        SingleLinkedList<std::string> list{"short", long_value};
+        const ListMemoryUsage usage = list.MemoryUsage();
+        assert(usage.value_heap_bytes >= long_value.capacity() + 1);
+        assert(usage.GetTotalBytes() == usage.node_bytes + usage.allocator_overhead
+                                        + usage.value_heap_bytes + usage.container_bytes);
+
+        SingleLinkedList<std::vector<std::string>> nested{{long_value, long_value}};
+        assert(nested.MemoryUsage().value_heap_bytes >= 2 * usage.value_heap_bytes);
+    }
+}
+
+void Test11() {
+    // Элемент, сравнение которого считается
+    struct Counted {
+        int value = 0;
+        int* comparisons = nullptr;
+
+        bool operator==(const Counted& rhs) const {
+            ++*comparisons;
+            return value == rhs.value;
+        }
+    };
+
+    // Списки разной длины и сравнение списка с самим собой - без обхода элементов
+    {
+        int comparisons = 0;
+        SingleLinkedList<Counted> longer{{1, &comparisons}, {2, &comparisons}, {3, &comparisons}};
+        SingleLinkedList<Counted> shorter{{1, &comparisons}};
+        assert(longer != shorter);
+        assert(shorter != longer);
+        assert(longer == longer);
+        assert(comparisons == 0);
+        shorter.InsertAfter(shorter.cbegin(), {2, &comparisons});
+        shorter.InsertAfter(++shorter.cbegin(), {4, &comparisons});
+        assert(longer != shorter);
+        assert(comparisons == 3);
+    }
+
+    // Сравнение уплотнённых, разбросанных и смешанных списков
+    const auto make = [](int size) {
+        SingleLinkedList<int> list;
+        auto pos = list.before_begin();
+        for (int i = 0; i < size; ++i) {
+            pos = list.InsertAfter(pos, i);
+        }
+        return list;
+    };
+    for (int size : {1, 63, 64, 65, 200}) {
+        SingleLinkedList<int> scattered = make(size);
+        SingleLinkedList<int> compact = make(size);
+        compact.Compact();
+        assert(scattered == compact && compact == scattered);
+        SingleLinkedList<int> other = make(size);
+        other.Compact();
+        assert(compact == other);
+
+        // Отличие в последнем элементе и в середине отрезка
+        auto last = other.begin();
+        for (int i = 1; i < size; ++i) {
+            ++last;
+        }
+        *last = -1;
+        assert(compact != other && scattered != other);
+        *last = size - 1;
+        *other.begin() = -1;
+        assert(compact != other);
+        *other.begin() = 0;
+
+        // Частично уплотнённый список: отрезки подряд чередуются с узлами в куче
+        other.PopFront();
+        other.PushFront(0);
+        other.CompactStep(size / 2);
+        assert(compact == other);
+    }
+
+    // Перечисления сравниваются как целые
+    enum class Color {Red, Green};
+    SingleLinkedList<Color> colors{Color::Red, Color::Green};
+    colors.Compact();
+    assert((colors == SingleLinkedList<Color>{Color::Red, Color::Green}));
+    assert((colors != SingleLinkedList<Color>{Color::Red, Color::Red}));
+    static_assert(IsBitwiseComparable<Color>::value && !IsBitwiseComparable<double>::value);
+}
+
+void Test12() {
+    using Cached = SingleLinkedList<unsigned>;
+    if constexpr (!EnableListHashCache<int>::value) {
+        // Выключенный кэш не занимает места
+        assert(sizeof(SingleLinkedList<int>) < sizeof(Cached));
+    }
+
+    // Хэш согласован с равенством и не зависит от того, как список построен и где лежат узлы
+    {
+        SingleLinkedList<int> list{1, 2, 3};
+        SingleLinkedList<int> built;
+        built.PushFront(3);
+        built.PushFront(2);
+        built.PushFront(1);
+        assert(std::hash<SingleLinkedList<int>>{}(list) == built.GetHash());
+        built.Compact();
+        assert(list.GetHash() == built.GetHash());
+        assert(list.GetHash() != SingleLinkedList<int>({3, 2, 1}).GetHash());
+        assert(list.GetHash() != SingleLinkedList<int>({1, 2}).GetHash());
+        assert(SingleLinkedList<int>().GetHash() != SingleLinkedList<int>({0}).GetHash());
+
+        std::unordered_set<SingleLinkedList<int>> unique{list, built, {3, 2, 1}, {}};
+        assert(unique.size() == 3u);
+    }
+
+    // Кэш обновляется при изменениях начала списка и сбрасывается при остальных
+    {
+        Cached list{2, 3};
+        const size_t initial = list.GetHash();
+        assert(initial == Cached({2, 3}).GetHash());
+
+        list.PushFront(1);
+        assert(list.GetHash() == Cached({1, 2, 3}).GetHash());
+        list.PopFront();
+        assert(list.GetHash() == initial);
+        list.InsertAfter(list.cbefore_begin(), 7);
+        assert(list.GetHash() == Cached({7, 2, 3}).GetHash());
+        list.EraseAfter(list.cbefore_begin());
+        assert(list.GetHash() == initial);
+
+        list.InsertAfter(list.cbegin(), 5);
+        assert(list.GetHash() == Cached({2, 5, 3}).GetHash());
+        list.EraseAfter(list.cbegin());
+        assert(list.GetHash() == initial);
+
+        *list.begin() = 4;
+        assert(list.GetHash() == Cached({4, 3}).GetHash());
+
+        // Изменение через итератор, полученный до вычисления хэша, требует явного сброса
+        auto it = list.begin();
+        assert(list.GetHash() == Cached({4, 3}).GetHash());
+        *it = 2;
+        list.InvalidateHash();
+        assert(list.GetHash() == initial);
+
+        Cached other{9};
+        const size_t other_hash = other.GetHash();
+        list.swap(other);
+        assert(list.GetHash() == other_hash && other.GetHash() == initial);
+
+        Cached tail{8};
+        list.SpliceAfter(list.cbegin(), tail, tail.cbegin());
+        assert(list.GetHash() == Cached({9, 8}).GetHash());
+        assert(tail.GetHash() == Cached().GetHash());
+
+        Cached copy(list);
+        assert(copy.GetHash() == list.GetHash());
+        list.Clear();
+        assert(list.GetHash() == Cached().GetHash());
+        list.PushFront(1);
+        assert(list.GetHash() == Cached({1}).GetHash());
+    }
+
+    // Строки хэшируются через std::hash
+    {
+        SingleLinkedList<std::string> list{"b", "c"};
+        list.PushFront("a");
+        assert(list.GetHash() == SingleLinkedList<std::string>({"a", "b", "c"}).GetHash());
+        list.PopFront();
+        assert(list.GetHash() == SingleLinkedList<std::string>({"b", "c"}).GetHash());
+    }
+}
+
+void Test13() {
+    // Побайтовые значения через буфер, несколько списков подряд
+    {
+        SingleLinkedList<int> numbers{1, 2, 3, 4, 5};
+        SingleLinkedList<int> empty;
+        std::vector<char> buffer;
+        ListByteWriter writer(buffer);
+        numbers.Serialize(writer);
+        empty.Serialize(writer);
+        assert(buffer.size() == 2 * sizeof(ListSerializationHeader) + 5 * sizeof(int));
+
+        ListByteReader reader(buffer.data(), buffer.size());
+        const auto restored = SingleLinkedList<int>::Deserialize(reader);
+        assert(restored == numbers);
+        assert(SingleLinkedList<int>::Deserialize(reader).IsEmpty());
+        assert(reader.GetRemaining() == 0u);
+
+        // Узлы прочитанного списка лежат в слабе
+        const ListMemoryUsage usage = restored.MemoryUsage();
+        assert(usage.pooled_nodes == 5u && usage.heap_nodes == 0u);
+    }
+
+    // Строки и значения с собственным кодеком через поток, в том числе длинные списки
+    {
+        SingleLinkedList<std::string> strings{"", "short", std::string(100, 'x')};
+        SingleLinkedList<Tagged> tagged{{1, "one"}, {2, std::string(50, 't')}};
+        SingleLinkedList<int> many;
+        for (int i = 0; i < 40000; ++i) {
+            many.PushFront(i);
+        }
+        std::stringstream stream;
+        strings.Serialize(stream);
+        tagged.Serialize(stream);
+        many.Serialize(stream);
+        assert(SingleLinkedList<std::string>::Deserialize(stream) == strings);
+        assert(SingleLinkedList<Tagged>::Deserialize(stream) == tagged);
+        auto restored = SingleLinkedList<int>::Deserialize(stream);
+        assert(restored == many);
+
+        // Прочитанный список - обычный список: изменения, хэш, уплотнение
+        assert(restored.GetHash() == many.GetHash());
+        restored.PopFront();
+        restored.PushFront(-1);
+        restored.InsertAfter(restored.cbegin(), -2);
+        restored.Compact();
+        assert(restored.GetSize() == many.GetSize() + 1);
+    }
+
+    // Повреждённые и неполные данные
+    {
+        std::vector<char> buffer;
+        ListByteWriter writer(buffer);
+        SingleLinkedList<int>{1, 2, 3}.Serialize(writer);
+
+        const auto fails = [](auto&& deserialize) {
+            try {
+                deserialize();
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        };
+        assert(fails([&] {
+            ListByteReader reader(buffer.data(), buffer.size() - 1);
+            (void)SingleLinkedList<int>::Deserialize(reader);
+        }));
+        assert(fails([&] {
+            ListByteReader reader(buffer.data(), buffer.size());
+            (void)SingleLinkedList<long long>::Deserialize(reader);
+        }));
+        assert(fails([&] {
+            ListByteReader reader(buffer.data(), buffer.size());
+            (void)SingleLinkedList<std::string>::Deserialize(reader);
+        }));
+        std::vector<char> corrupted = buffer;
+        corrupted[0] = 'X';
+        assert(fails([&] {
+            ListByteReader reader(corrupted.data(), corrupted.size());
+            (void)SingleLinkedList<int>::Deserialize(reader);
+        }));
+        std::stringstream truncated(std::string(buffer.data(), buffer.size() - 2));
+        assert(fails([&] {
+            (void)SingleLinkedList<int>::Deserialize(truncated);
+        }));
+
+        // Огромная длина в заголовке там, где её нельзя сверить с размером входа (поток, кодек),
+        // не выделяет память под все узлы сразу: чтение упирается в конец данных
+        const auto with_count = [](std::vector<char> data, std::uint64_t count) {
+            std::memcpy(data.data() + offsetof(ListSerializationHeader, count), &count, sizeof(count));
+            return std::string(data.begin(), data.end());
+        };
+        const std::uint64_t huge = std::uint64_t{1} << 40;
+        std::stringstream huge_stream(with_count(buffer, huge));
+        assert(fails([&] {
+            (void)SingleLinkedList<int>::Deserialize(huge_stream);
+        }));
+        std::vector<char> strings;
+        ListByteWriter strings_writer(strings);
+        SingleLinkedList<std::string>{"a", "b"}.Serialize(strings_writer);
+        const std::string huge_strings = with_count(strings, huge);
+        assert(fails([&] {
+            ListByteReader reader(huge_strings.data(), huge_strings.size());
+            (void)SingleLinkedList<std::string>::Deserialize(reader);
+        }));
+
+        // Огромная длина строки в потоке: строка растёт по мере чтения и упирается в конец данных
+        std::vector<char> huge_length = strings;
+        std::memcpy(huge_length.data() + sizeof(ListSerializationHeader), &huge, sizeof(huge));
+        std::stringstream huge_length_stream(std::string(huge_length.begin(), huge_length.end()));
+        assert(fails([&] {
+            (void)SingleLinkedList<std::string>::Deserialize(huge_length_stream);
+        }));
+        const SingleLinkedList<std::string> long_strings{std::string(200000, 'l'), "s"};
+        std::stringstream long_strings_stream;
+        long_strings.Serialize(long_strings_stream);
+        assert(SingleLinkedList<std::string>::Deserialize(long_strings_stream) == long_strings);
+
+        // Длинный список из потока читается в несколько растущих слабов
+        SingleLinkedList<int> long_list;
+        for (int i = 0; i < 10000; ++i) {
+            long_list.PushFront(i);
+        }
+        std::stringstream long_stream;
+        long_list.Serialize(long_stream);
+        const auto restored = SingleLinkedList<int>::Deserialize(long_stream);
+        assert(restored == long_list);
+        assert(restored.MemoryUsage().pooled_nodes == 10000u);
+    }
+
+    // Исключение из кодека посреди чтения не оставляет утечек
+    {
+        SingleLinkedList<Tagged> tagged{{1, "a"}, {-1, "b"}, {3, "c"}};
+        std::vector<char> buffer;
+        ListByteWriter writer(buffer);
+        tagged.Serialize(writer);
+        ListByteReader reader(buffer.data(), buffer.size());
+        try {
+            (void)SingleLinkedList<Tagged>::Deserialize(reader);
+            assert(false);
+        } catch (const std::invalid_argument&) {
+        }
+    }
+
+    // Чтение выделяет память под узлы одним обращением к куче
+    {
+        using ProbeList = SingleLinkedList<StatsProbe>;
+        ProbeList list;
+        for (int i = 0; i < 100; ++i) {
+            list.PushFront(StatsProbe{i});
+        }
+        std::vector<char> buffer;
+        ListByteWriter writer(buffer);
+        list.Serialize(writer);
+        ListStatsRegistry<StatsProbe>::Reset();
+        {
+            ListByteReader reader(buffer.data(), buffer.size());
+            const auto restored = ProbeList::Deserialize(reader);
+            assert(restored.GetSize() == 100u && restored.begin()->value == 99);
+            assert(ProbeList::GetStats().heap_allocations == 1u);
+            assert(ProbeList::GetStats().nodes_created == 100u);
+        }
+        assert(ProbeList::GetStats().heap_frees == 1u);
+    }
+}
+
+void Test14() {
+    struct Point {
+        int x = 0;
+        double y = 0.0;
+    };
+
+    // Запись в файл, отображение и обход без копирования
+    {
+        SingleLinkedList<Point> points;
+        for (int i = 0; i < 1000; ++i) {
+            points.PushFront({i, i * 0.5});
+        }
+        const std::string path = (std::filesystem::temp_directory_path() / "sll_mapped_test.bin").string();
+        MappedSingleLinkedList<Point>::Write(points, path);
+        {
+            auto mapped = MappedSingleLinkedList<Point>::Open(path);
+            assert(mapped.GetSize() == points.GetSize());
+            assert(mapped.Validate());
+            auto expected = points.cbegin();
+            for (const Point& point : mapped) {
+                assert(point.x == expected->x && point.y == expected->y);
+                ++expected;
+            }
+            assert(expected == points.cend());
+
+            MappedSingleLinkedList<Point> moved(std::move(mapped));
+            assert(moved.GetSize() == 1000u && mapped.IsEmpty());
+            assert(moved.begin()->x == 999);
+        }
+        std::remove(path.c_str());
+
+        // Файла больше нет
+        bool failed = false;
+        try {
+            (void)MappedSingleLinkedList<Point>::Open(path);
+        } catch (const std::runtime_error&) {
+            failed = true;
+        }
+        assert(failed);
+    }
+
+    // Представление над буфером в памяти
+    {
+        SingleLinkedList<std::uint16_t> list{1, 2, 3};
+        std::ostringstream out;
+        MappedSingleLinkedList<std::uint16_t>::Write(list, out);
+        const std::string bytes = out.str();
+        std::vector<std::uint64_t> aligned((bytes.size() + 7) / 8);
+        std::memcpy(aligned.data(), bytes.data(), bytes.size());
+
+        const MappedSingleLinkedList<std::uint16_t> view(aligned.data(), bytes.size());
+        assert(std::equal(view.begin(), view.end(), list.begin(), list.end()));
+        assert(view.Validate());
+
+        // Смещение, указывающее за пределы буфера, обнаруживает Validate
+        std::vector<std::uint64_t> corrupted = aligned;
+        const std::int64_t bad_next = 1 << 20;
+        std::memcpy(reinterpret_cast<char*>(corrupted.data()) + sizeof(MappedListHeader), &bad_next, sizeof(bad_next));
+        assert(!MappedSingleLinkedList<std::uint16_t>(corrupted.data(), bytes.size()).Validate());
+
+        // Длина из заголовка, не совпадающая с цепочкой
+        assert(!MappedSingleLinkedList<std::uint16_t>(aligned.data(), bytes.size() - 16).Validate());
+
+        const auto fails = [&](const void* data, size_t size) {
+            try {
+                MappedSingleLinkedList<std::uint32_t> wrong(data, size);
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        };
+        assert(fails(aligned.data(), bytes.size()));
+        assert(fails(aligned.data(), 4));
+
+        std::ostringstream empty_out;
+        MappedSingleLinkedList<std::uint16_t>::Write(SingleLinkedList<std::uint16_t>{}, empty_out);
+        const std::string empty_bytes = empty_out.str();
+        std::vector<std::uint64_t> empty_aligned((empty_bytes.size() + 7) / 8);
+        std::memcpy(empty_aligned.data(), empty_bytes.data(), empty_bytes.size());
+        const MappedSingleLinkedList<std::uint16_t> empty(empty_aligned.data(), empty_bytes.size());
+        assert(empty.IsEmpty() && empty.begin() == empty.end() && empty.Validate());
+    }
+}
+
+void Test15() {
+    SingleLinkedList<int> numbers;
+    for (int i = 999; i >= 0; --i) {
+        numbers.PushFront(i);
+    }
+    SingleLinkedList<std::string> strings{"a", "bb", "ccc", "dddd", "eeeee"};
+
+    // Чтение частями: каждая часть - отдельный список не длиннее chunk_size
+    {
+        std::stringstream stream;
+        numbers.Serialize(stream);
+        ListStreamReader<int> reader(stream, 300);
+        assert(reader.GetSize() == 1000u);
+        int expected = 0;
+        size_t chunks = 0;
+        while (!reader.IsDone()) {
+            const auto chunk = reader.ReadChunk();
+            assert(chunk.GetSize() <= 300u);
+            for (int value : chunk) {
+                assert(value == expected++);
+            }
+            ++chunks;
+        }
+        assert(expected == 1000 && chunks == 4u);
+        assert(reader.ReadChunk().IsEmpty());
+    }
+
+    // Сборка целого списка через хвостовой итератор
+    {
+        std::vector<char> buffer;
+        ListByteWriter writer(buffer);
+        numbers.Serialize(writer);
+        strings.Serialize(writer);
+        ListByteReader bytes(buffer.data(), buffer.size());
+
+        ListStreamReader<int> reader(bytes, 64);
+        SingleLinkedList<int> restored{-1};
+        auto tail = restored.cbegin();
+        while (!reader.IsDone()) {
+            tail = reader.AppendChunk(restored, tail);
+        }
+        assert(reader.AppendChunk(restored, tail) == tail);
+        assert(restored.GetSize() == 1001u && *tail == 999);
+        restored.PopFront();
+        assert(restored == numbers);
+        restored.Clear();
+
+        // Строки без создания узлов; читатель продолжает с того места буфера, где остановился предыдущий
+        ListStreamReader<std::string> string_reader(bytes, 2);
+        std::vector<std::string> values;
+        string_reader.ForEach([&values](std::string&& value) {
+            values.push_back(std::move(value));
+        });
+        assert(values == std::vector<std::string>(strings.begin(), strings.end()));
+        assert(bytes.GetRemaining() == 0u);
+    }
+
+    // Побайтовые значения через ForEach из потока; обрыв данных посреди чтения
+    {
+        std::stringstream stream;
+        numbers.Serialize(stream);
+        ListStreamReader<int> reader(stream, 100);
+        long long sum = 0;
+        reader.ForEach([&sum](int value) { sum += value; });
+        assert(sum == 999 * 1000 / 2 && reader.IsDone());
+
+        std::string bytes;
+        {
+            std::stringstream full;
+            numbers.Serialize(full);
+            bytes = full.str();
+        }
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 10));
+        ListStreamReader<int> truncated_reader(truncated, 256);
+        bool failed = false;
+        try {
+            while (!truncated_reader.IsDone()) {
+                (void)truncated_reader.ReadChunk();
+            }
+        } catch (const std::runtime_error&) {
+            failed = true;
+        }
+        assert(failed);
+    }
+}
+
+void Test16() {
+    using List = PersistentSingleLinkedList<int>;
+
+    // Версии не влияют друг на друга и делят хвосты
+    {
+        const List empty;
+        const List one = empty.PushFront(1);
+        const List two = one.PushFront(2);
+        const List other = one.PushFront(3);
+        assert(empty.IsEmpty() && one.GetSize() == 1u && two.GetSize() == 2u);
+        assert(two.Front() == 2 && other.Front() == 3);
+        assert((two == List{2, 1}) && (other == List{3, 1}) && (one == List{1}));
+        assert(two.SharesTailWith(other) && two.SharesTailWith(one) && !two.SharesTailWith(List{2, 1}));
+        assert(two.PopFront() == one && &*two.PopFront().begin() == &*one.begin());
+        assert(two != other);
+
+        std::vector<int> values(two.begin(), two.end());
+        assert((values == std::vector<int>{2, 1}));
+    }
+
+    // Снимок за O(1) не копирует элементы и переживает исходную версию
+    {
+        int alive = 0;
+        // Конструктор по умолчанию нужен только фиктивному узлу и не считается
+        struct Counted {
+            Counted() = default;
+            explicit Counted(int& counter) : counter_(&counter) {
+                ++*counter_;
+            }
+            Counted(const Counted& other) : counter_(other.counter_) {
+                if (counter_ != nullptr) {
+                    ++*counter_;
+                }
+            }
+            ~Counted() {
+                if (counter_ != nullptr) {
+                    --*counter_;
+                }
+            }
+            int* counter_ = nullptr;
+        };
+        PersistentSingleLinkedList<Counted> list;
+        for (int i = 0; i < 100; ++i) {
+            list = list.PushFront(Counted(alive));
+        }
+        assert(alive == 100);
+        PersistentSingleLinkedList<Counted> snapshot = list;
+        assert(alive == 100);
+        list = list.PopFront().PopFront();
+        assert(alive == 100 && snapshot.GetSize() == 100u && list.GetSize() == 98u);
+        snapshot = PersistentSingleLinkedList<Counted>();
+        assert(alive == 98);
+        list = PersistentSingleLinkedList<Counted>();
+        assert(alive == 0);
+    }
+
+    // Длинная цепочка освобождается без рекурсии; версии можно читать из разных потоков
+    {
+        List list;
+        for (int i = 0; i < 200000; ++i) {
+            list = list.PushFront(i);
+        }
+        const List snapshot = list;
+        std::vector<std::thread> readers;
+        std::vector<long long> sums(4, 0);
+        for (size_t t = 0; t < sums.size(); ++t) {
+            readers.emplace_back([version = snapshot.PopFront(), &sum = sums[t]] {
+                for (int value : version) {
+                    sum += value;
+                }
+            });
+        }
+        list = List(snapshot.begin(), snapshot.end());
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        for (long long sum : sums) {
+            assert(sum == 199999LL * 200000 / 2 - 199999);
+        }
+        assert(list == snapshot && !list.SharesTailWith(snapshot));
+    }
+}
+
+void Test17() {
+    using List = CowSingleLinkedList<int>;
+
+    // Копии делят узлы, пока их не меняют; PushFront и PopFront не копируют общие узлы
+    {
+        List list{1, 2, 3};
+        const List copy = list;
+        assert(&*copy.begin() == &*list.begin());
+        list.PushFront(0);
+        assert((list == List{0, 1, 2, 3}) && (copy == List{1, 2, 3}));
+        assert(&*std::next(list.begin()) == &*copy.begin());
+        list.PopFront();
+        list.PopFront();
+        assert((list == List{2, 3}) && (copy == List{1, 2, 3}));
+        assert(&*list.begin() == &*std::next(copy.begin()));
+    }
+
+    // InsertAfter и EraseAfter копируют только узлы до места изменения, хвост остаётся общим
+    {
+        List list{1, 2, 3, 4, 5};
+        List copy = list;
+        auto pos = list.InsertAfter(std::next(list.begin()), 10);
+        assert(*pos == 10);
+        assert((list == List{1, 2, 10, 3, 4, 5}) && (copy == List{1, 2, 3, 4, 5}));
+        assert(&*list.begin() != &*copy.begin());
+        assert(&*std::next(list.begin(), 3) == &*std::next(copy.begin(), 2));
+
+        // Скопированная часть принадлежит только list и меняется на месте
+        const int* first = &*list.begin();
+        list.EraseAfter(list.begin());
+        assert(&*list.begin() == first && (list == List{1, 10, 3, 4, 5}));
+
+        pos = copy.EraseAfter(std::next(copy.begin(), 3));
+        assert(pos == copy.end() && (copy == List{1, 2, 3, 4}));
+        assert((list == List{1, 10, 3, 4, 5}));
+        copy.EraseAfter(copy.before_begin());
+        assert((copy == List{2, 3, 4}));
+    }
+
+    // Элементы не копируются при копировании списков и освобождаются вместе с последним владельцем
+    {
+        int alive = 0;
+        // Конструктор по умолчанию нужен только фиктивному узлу и не считается
+        struct Counted {
+            Counted() = default;
+            explicit Counted(int& counter) : counter_(&counter) {
+                ++*counter_;
+            }
+            Counted(const Counted& other) : counter_(other.counter_) {
+                if (counter_ != nullptr) {
+                    ++*counter_;
+                }
+            }
+            ~Counted() {
+                if (counter_ != nullptr) {
+                    --*counter_;
+                }
+            }
+            int* counter_ = nullptr;
+        };
+        auto list = std::make_unique<CowSingleLinkedList<Counted>>();
+        for (int i = 0; i < 100; ++i) {
+            list->PushFront(Counted(alive));
+        }
+        std::vector<CowSingleLinkedList<Counted>> readers(10, *list);
+        assert(alive == 100);
+        list->InsertAfter(std::next(list->begin(), 9), Counted(alive));
+        assert(alive == 111 && list->GetSize() == 101u);
+        list.reset();
+        assert(alive == 100);
+        readers.clear();
+        assert(alive == 0);
+    }
+
+    // Если других владельцев не осталось, изменения идут на месте
+    {
+        List list{1, 2, 3};
+        {
+            const List copy = list;
+        }
+        const int* second = &*std::next(list.begin());
+        list.InsertAfter(std::next(list.begin(), 2), 4);
+        assert(&*std::next(list.begin()) == second && (list == List{1, 2, 3, 4}));
+        list.Clear();
+        assert(list.IsEmpty() && list.begin() == list.end());
+    }
+}
+
+void Test18() {
+    // Позиционный доступ совпадает с обходом и для списков с индексом, и без него
+    const auto check = [](const auto& list, const std::vector<long>& expected) {
+        assert(list.GetSize() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(list.At(i) == expected[i]);
+            assert(*list.IteratorAt(i) == expected[i]);
+        }
+        assert(list.IteratorAt(expected.size()) == list.end());
+        for (size_t from : {size_t{0}, size_t{1}, expected.size() / 3, expected.size() / 2}) {
+            if (from >= expected.size()) {
+                continue;
+            }
+            for (size_t distance : {size_t{0}, size_t{1}, size_t{31}, size_t{32}, size_t{33}, size_t{100}}) {
+                if (from + distance < expected.size()) {
+                    assert(*list.Advance(list.IteratorAt(from), distance) == expected[from + distance]);
+                }
+            }
+            assert(list.Advance(list.IteratorAt(from), expected.size() - from) == list.end());
+        }
+        if (!expected.empty()) {
+            assert(*list.Advance(list.before_begin(), expected.size()) == expected.back());
+        }
+        assert(list.Advance(list.before_begin(), expected.size() + 1) == list.end());
+        try {
+            (void)list.At(expected.size());
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    };
+
+    const auto run = [&check](auto list) {
+        std::vector<long> expected;
+        for (long i = 0; i < 1000; ++i) {
+            list.PushFront(i);
+            expected.insert(expected.begin(), i);
+        }
+        check(list, expected);
+
+        // Изменения в начале списка поддерживают индекс, остальные - сбрасывают
+        list.PopFront();
+        list.PopFront();
+        list.InsertAfter(list.before_begin(), -1);
+        expected.erase(expected.begin(), expected.begin() + 2);
+        expected.insert(expected.begin(), -1);
+        check(list, expected);
+
+        list.InsertAfter(list.IteratorAt(500), -2);
+        expected.insert(expected.begin() + 501, -2);
+        list.EraseAfter(list.IteratorAt(10));
+        expected.erase(expected.begin() + 11);
+        check(list, expected);
+
+        list.At(7) = 70;
+        expected[7] = 70;
+        assert(list.At(7) == 70);
+
+        list.Compact();
+        check(list, expected);
+
+        decltype(list) tail{100, 200, 300};
+        list.SpliceAfter(list.IteratorAt(expected.size() - 1), tail, tail.IteratorAt(2));
+        expected.insert(expected.end(), {100, 200, 300});
+        check(list, expected);
+        check(tail, {});
+
+        const auto copy = list;
+        check(copy, expected);
+        auto moved = std::move(list);
+        check(moved, expected);
+
+        moved.Clear();
+        check(moved, {});
+        moved.PushFront(5);
+        check(moved, {5});
+    };
+    run(SingleLinkedList<long>{});
+    run(SingleLinkedList<int>{});
+
+    // Константные обращения не перестраивают сброшенный индекс и поэтому безопасны из нескольких потоков.
+    // Неконстантные перестраивают его
+    {
+        SingleLinkedList<long> list;
+        std::vector<long> expected;
+        for (long i = 0; i < 2000; ++i) {
+            list.PushFront(i);
+            expected.insert(expected.begin(), i);
+        }
+        list.InsertAfter(list.IteratorAt(1000), -1);
+        expected.insert(expected.begin() + 1001, -1);
+
+        const SingleLinkedList<long>& shared = list;
+        std::vector<std::thread> readers;
+        for (size_t t = 0; t < 4; ++t) {
+            readers.emplace_back([&shared, &expected, t] {
+                for (size_t i = t; i < expected.size(); i += 4) {
+                    assert(shared.At(i) == expected[i]);
+                    assert(*shared.Advance(shared.IteratorAt(i / 2), i - i / 2) == expected[i]);
+                }
+            });
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        assert(list.At(1500) == expected[1500]);
+        assert(*list.Advance(list.begin(), 1700) == expected[1700]);
+        check(shared, expected);
+    }
+
+    // Выключенный индекс не занимает места в списке
+    if constexpr (!EnableListPositionIndex<int>::value) {
+        assert(sizeof(SingleLinkedList<int>) < sizeof(SingleLinkedList<long>));
+    }
+}
+
+void Test19() {
+    using List = SortedSingleLinkedList<int>;
+
+    // Элементы идут по возрастанию, поиск совпадает с std::lower_bound/upper_bound по отсортированному массиву
+    {
+        const List list{5, 1, 4, 1, 3};
+        assert((std::vector<int>(list.begin(), list.end()) == std::vector<int>{1, 1, 3, 4, 5}));
+        assert(list.LowerBound(1) == list.begin() && *list.UpperBound(1) == 3);
+        assert(*list.LowerBound(2) == 3 && list.Find(2) == list.end() && *list.Find(4) == 4);
+        assert(list.LowerBound(6) == list.end() && list.Find(0) == list.end());
+        assert(List{}.LowerBound(1) == List{}.end());
+    }
+
+    // Случайные вставки и удаления на длинном списке, в том числе длинные серии равных элементов
+    {
+        List list;
+        std::vector<int> expected;
+        std::mt19937 generator(3);
+        for (int i = 0; i < 20000; ++i) {
+            const int value = static_cast<int>(generator() % 500) * (i % 1000 < 200 ? 0 : 1);
+            if (generator() % 4 != 0) {
+                const auto it = list.InsertSorted(value);
+                assert(*it == value);
+                expected.insert(std::upper_bound(expected.begin(), expected.end(), value), value);
+            } else {
+                const auto [first, last] = std::equal_range(expected.begin(), expected.end(), value);
+                const size_t count = static_cast<size_t>(last - first);
+                expected.erase(first, last);
+                assert(list.EraseValue(value) == count);
+            }
+            if (i % 1000 == 999) {
+                assert(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+                for (int probe = -1; probe <= 500; probe += 7) {
+                    const auto lower = std::lower_bound(expected.begin(), expected.end(), probe);
+                    assert(std::distance(list.begin(), list.LowerBound(probe)) == lower - expected.begin());
+                    const auto upper = std::upper_bound(expected.begin(), expected.end(), probe);
+                    assert(std::distance(list.begin(), list.UpperBound(probe)) == upper - expected.begin());
+                    assert((list.Find(probe) != list.end()) == (lower != upper));
+                }
+            }
+        }
+        assert(list.GetSize() == expected.size() && list.GetList().GetSize() == expected.size());
+
+        // Копия выбирает свои опорные узлы; перемещение сохраняет прежние
+        List copy = list;
+        assert(std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+        copy.InsertSorted(-5);
+        assert(*copy.begin() == -5 && *list.begin() != -5);
+        List moved = std::move(copy);
+        assert(moved.EraseValue(-5) == 1 && moved.Find(250) == moved.LowerBound(250));
+        while (!expected.empty()) {
+            const int value = expected.back();
+            expected.erase(std::lower_bound(expected.begin(), expected.end(), value), expected.end());
+            moved.EraseValue(value);
+            assert(std::equal(moved.begin(), moved.end(), expected.begin(), expected.end()));
+        }
+        assert(moved.IsEmpty());
+        list.Clear();
+        assert(list.IsEmpty() && list.Find(1) == list.end());
+    }
+
+    // Свой порядок; равные по ключу элементы остаются в порядке вставки
+    {
+        struct ByKey {
+            bool operator()(const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) const {
+                return lhs.first > rhs.first;
+            }
+        };
+        SortedSingleLinkedList<std::pair<int, int>, ByKey> list;
+        for (int i = 0; i < 200; ++i) {
+            list.InsertSorted({i % 3, i});
+        }
+        int previous_key = 3;
+        int previous_order = -1;
+        for (const auto& [key, order] : list) {
+            assert(key <= previous_key);
+            assert(key < previous_key || order > previous_order);
+            previous_key = key;
+            previous_order = order;
+        }
+        assert(list.EraseValue({1, 0}) == 67 && list.GetSize() == 133u);
+    }
+}
+
+void Test20() {
+    using List = HashIndexedSingleLinkedList<int>;
+
+    // Порядок элементов - как у обычного списка, поиск находит элементы по значению
+    {
+        List list{1, 2, 3};
+        list.PushFront(0);
+        const auto it = list.InsertAfter(list.Find(2), 5);
+        assert(*it == 5 && (std::vector<int>(list.begin(), list.end()) == std::vector<int>{0, 1, 2, 5, 3}));
+        assert(list.Contains(5) && list.Contains(0) && !list.Contains(4));
+        assert(*list.Find(3) == 3 && list.Find(4) == list.end());
+        assert(list.EraseAfter(list.Find(1)) == list.Find(5));
+        list.PopFront();
+        assert((std::vector<int>(list.begin(), list.end()) == std::vector<int>{1, 5, 3}));
+        assert(!list.Contains(0) && !list.Contains(2));
+    }
+
+    // Случайные изменения сверяются с обычным списком; повторяющиеся значения удаляются все сразу
+    {
+        List list;
+        SingleLinkedList<int> expected;
+        std::mt19937 generator(5);
+        for (int i = 0; i < 20000; ++i) {
+            const int value = static_cast<int>(generator() % 300);
+            switch (generator() % 5) {
+            case 0:
+            case 1:
+                list.PushFront(value);
+                expected.PushFront(value);
+                break;
+            case 2:
+                if (const auto pos = list.Find(value); pos != list.end()) {
+                    // Из равных элементов Find возвращает какой-то один: вставка в модель - на ту же позицию
+                    expected.InsertAfter(std::next(expected.cbegin(), std::distance(list.begin(), pos)), value + 1);
+                    list.InsertAfter(pos, value + 1);
+                }
+                break;
+            case 3: {
+                const size_t count = static_cast<size_t>(std::count(expected.begin(), expected.end(), value));
+                assert(list.EraseValue(value) == count);
+                for (auto prev = expected.cbefore_begin(); std::next(prev) != expected.cend();) {
+                    if (*std::next(prev) == value) {
+                        expected.EraseAfter(prev);
+                    } else {
+                        ++prev;
+                    }
+                }
+                break;
+            }
+            default:
+                if (!list.IsEmpty()) {
+                    list.PopFront();
+                    expected.PopFront();
+                }
+            }
+            if (i % 1000 == 999) {
+                assert(list.GetList() == expected);
+                for (int probe = 0; probe <= 301; ++probe) {
+                    const bool present = std::find(expected.begin(), expected.end(), probe) != expected.end();
+                    assert(list.Contains(probe) == present);
+                    assert(!present || *list.Find(probe) == probe);
+                }
+            }
+        }
+
+        // Копия строит свой индекс, перемещённый список сохраняет прежний
+        List copy = list;
+        assert(copy.GetList() == expected);
+        List moved = std::move(list);
+        for (int value : expected) {
+            assert(copy.Contains(value) && moved.Contains(value));
+        }
+        moved.Clear();
+        assert(moved.IsEmpty() && !moved.Contains(1));
+        moved.PushFront(1);
+        assert(moved.Contains(1));
+    }
+
+    // Все значения в одной ячейке: цепочки проб и удаление со сдвигом остаются правильными
+    {
+        struct SameHash {
+            size_t operator()(int) const {return 0;}
+        };
+        HashIndexedSingleLinkedList<int, SameHash> list;
+        for (int i = 0; i < 100; ++i) {
+            list.PushFront(i % 10);
+        }
+        for (int i = 0; i < 10; i += 2) {
+            assert(list.EraseValue(i) == 10u);
+        }
+        assert(list.GetSize() == 50u);
+        for (int i = 0; i < 10; ++i) {
+            assert(list.Contains(i) == (i % 2 == 1));
+        }
+    }
+}
+
+void Test21() {
+    using Cache = LruCache<int, std::string>;
+
+    // Вытесняется давно не использованная запись; Get и Put делают запись самой свежей
+    {
+        std::vector<std::pair<int, std::string>> evicted;
+        Cache cache(3, [&](const int& key, std::string& value) {
+            evicted.emplace_back(key, std::move(value));
+        });
+        cache.Put(1, "one");
+        cache.Put(2, "two");
+        cache.Put(3, "three");
+        assert(cache.GetSize() == 3u && cache.GetCapacity() == 3u);
+        assert(*cache.Get(1) == "one");
+        cache.Put(4, "four");
+        assert((evicted == std::vector<std::pair<int, std::string>>{{2, "two"}}));
+        assert(!cache.Contains(2) && cache.Get(2) == nullptr);
+        cache.Put(3, "drei");
+        cache.Put(5, "five");
+        assert(evicted.back().first == 1 && evicted.back().second == "one");
+
+        std::vector<int> order;
+        cache.ForEach([&](const int& key, const std::string&) {
+            order.push_back(key);
+        });
+        assert((order == std::vector<int>{5, 3, 4}));
+
+        // Peek не меняет порядок и счётчики
+        assert(*cache.Peek(4) == "four" && cache.Peek(1) == nullptr);
+        const LruCacheStats stats = cache.GetStats();
+        assert(stats.hits == 1u && stats.misses == 1u && stats.evictions == 2u);
+        assert(stats.GetHitRate() == 0.5);
+        cache.ResetStats();
+        assert(cache.GetStats().hits == 0u && cache.GetStats().GetHitRate() == 0.0);
+
+        // Erase не вызывает on_evict, Clear освобождает все записи
+        assert(cache.Erase(3) && !cache.Erase(3));
+        assert(cache.GetSize() == 2u && evicted.size() == 2u);
+        cache.Put(6, "six");
+        cache.Put(7, "seven");
+        assert(evicted.size() == 3u && evicted.back().first == 4);
+        cache.Clear();
+        assert(cache.GetSize() == 0u && !cache.Contains(5) && evicted.size() == 3u);
+        cache.Put(8, "eight");
+        assert(*cache.Get(8) == "eight");
+    }
+
+    // Случайные обращения сверяются с моделью на std::list и std::unordered_map
+    {
+        constexpr size_t kCapacity = 64;
+        LruCache<int, int> cache(kCapacity);
+        std::list<std::pair<int, int>> order;
+        std::unordered_map<int, std::list<std::pair<int, int>>::iterator> positions;
+        std::mt19937 generator(7);
+        for (int i = 0; i < 50000; ++i) {
+            const int key = static_cast<int>(generator() % 200);
+            const auto found = positions.find(key);
+            switch (generator() % 3) {
+            case 0: {
+                const int* value = cache.Get(key);
+                assert((value != nullptr) == (found != positions.end()));
+                if (value != nullptr) {
+                    assert(*value == found->second->second);
+                    order.splice(order.begin(), order, found->second);
+                }
+                break;
+            }
+            case 1:
+                cache.Put(key, i);
+                if (found != positions.end()) {
+                    found->second->second = i;
+                    order.splice(order.begin(), order, found->second);
+                } else {
+                    if (order.size() == kCapacity) {
+                        positions.erase(order.back().first);
+                        order.pop_back();
+                    }
+                    order.emplace_front(key, i);
+                    positions[key] = order.begin();
+                }
+                break;
+            default:
+                assert(cache.Erase(key) == (found != positions.end()));
+                if (found != positions.end()) {
+                    order.erase(found->second);
+                    positions.erase(found);
+                }
+            }
+            if (i % 1000 == 999) {
+                assert(cache.GetSize() == order.size());
+                auto expected = order.begin();
+                cache.ForEach([&](const int& key, const int& value) {
+                    assert(key == expected->first && value == expected->second);
+                    ++expected;
+                });
+            }
+        }
+    }
+
+    // Все ключи в одной цепочке проб: перенос в начало и вытеснение находят нужные ячейки
+    {
+        struct SameHash {
+            size_t operator()(int) const {return 0;}
+        };
+        LruCache<int, int, SameHash> cache(16);
+        for (int i = 0; i < 40; ++i) {
+            cache.Put(i, i * 10);
+            if (i >= 2) {
+                assert(*cache.Get(i - 2) == (i - 2) * 10);
+            }
+        }
+        assert(cache.GetSize() == 16u);
+        for (int i = 0; i < 40; ++i) {
+            assert(cache.Contains(i) == (i >= 24));
+        }
+        for (int i = 24; i < 40; i += 2) {
+            assert(cache.Erase(i));
+        }
+        for (int i = 25; i < 40; i += 2) {
+            assert(*cache.Get(i) == i * 10);
+        }
+    }
+}
+
+void Test22() {
+    using Map = LinkedHashMap<int, std::string>;
+
+    // Вставка не заменяет значение существующего ключа, InsertOrAssign - заменяет
+    {
+        Map map;
+        assert(map.IsEmpty() && map.Find(1) == nullptr && !map.Erase(1));
+        const auto [value, inserted] = map.Insert(1, "one");
+        assert(inserted && *value == "one");
+        assert(!map.Insert(1, "uno").second && *map.Find(1) == "one");
+        map.InsertOrAssign(1, "uno");
+        map.InsertOrAssign(2, "two");
+        assert(map.GetSize() == 2u && *map.Find(1) == "uno" && *map.Find(2) == "two");
+        *map.Find(2) = "zwei";
+        assert(*std::as_const(map).Find(2) == "zwei");
+        assert(map.Erase(1) && !map.Erase(1) && !map.Contains(1) && map.GetSize() == 1u);
+        map.Clear();
+        assert(map.IsEmpty() && !map.Contains(2));
+        map.Insert(3, "three");
+        assert(*map.Find(3) == "three");
+    }
+
+    // Случайные операции сверяются с std::unordered_map, в том числе посреди перехэширования
+    {
+        Map map;
+        std::unordered_map<int, std::string> expected;
+        std::mt19937 generator(11);
+        bool seen_rehashing = false;
+        for (int i = 0; i < 100000; ++i) {
+            const int key = static_cast<int>(generator() % 20000);
+            switch (generator() % 4) {
+            case 0:
+            case 1: {
+                const auto [value, inserted] = map.Insert(key, std::to_string(i));
+                const auto [it, expected_inserted] = expected.emplace(key, std::to_string(i));
+                assert(inserted == expected_inserted && *value == it->second);
+                break;
+            }
+            case 2:
+                assert(map.Erase(key) == (expected.erase(key) == 1));
+                break;
+            default: {
+                const std::string* value = std::as_const(map).Find(key);
+                const auto it = expected.find(key);
+                assert((value != nullptr) == (it != expected.end()));
+                assert(value == nullptr || *value == it->second);
+            }
+            }
+            seen_rehashing = seen_rehashing || map.IsRehashing();
+            assert(map.GetSize() == expected.size());
+        }
+        assert(seen_rehashing && map.GetBucketCount() >= map.GetSize());
+
+        size_t visited = 0;
+        map.ForEach([&](const int& key, const std::string& value) {
+            assert(expected.at(key) == value);
+            ++visited;
+        });
+        assert(visited == expected.size());
+
+        // Копия выделяет свои узлы, перемещённая таблица сохраняет прежние
+        Map copy = map;
+        Map moved = std::move(map);
+        assert(map.IsEmpty() && !map.Contains(0));
+        for (const auto& [key, value] : expected) {
+            assert(*copy.Find(key) == value && *moved.Find(key) == value);
+        }
+        copy.InsertOrAssign(-1, "copy");
+        assert(!moved.Contains(-1));
+        map = copy;
+        assert(map.GetSize() == copy.GetSize() && *map.Find(-1) == "copy");
+    }
+
+    // Все ключи в одной корзине
+    {
+        struct SameHash {
+            size_t operator()(int) const {return 0;}
+        };
+        LinkedHashMap<int, int, SameHash> map;
+        for (int i = 0; i < 100; ++i) {
+            map.Insert(i, i * i);
+        }
+        for (int i = 0; i < 100; i += 3) {
+            assert(map.Erase(i));
+        }
+        for (int i = 0; i < 100; ++i) {
+            const int* value = map.Find(i);
+            assert((value != nullptr) == (i % 3 != 0) && (value == nullptr || *value == i * i));
+        }
+    }
+
+    // Перехэширование берёт хэш из узла и не вызывает Hash: выбрасывающий хэш не мешает переносу корзин
+    {
+        static bool refuse_13 = false;
+        static size_t hash_calls = 0;
+        struct PickyHash {
+            size_t operator()(int key) const {
+                ++hash_calls;
+                if (refuse_13 && key == 13) {
+                    throw std::runtime_error("hash refused");
+                }
+                return std::hash<int>{}(key);
+            }
+        };
+        LinkedHashMap<int, int, PickyHash> map;
+        for (int i = 0; i < 100; ++i) {
+            map.Insert(i, i);
+        }
+        refuse_13 = true;
+        hash_calls = 0;
+        bool seen_rehashing = false;
+        for (int i = 100; i < 5000; ++i) {
+            map.Insert(i, i);
+            seen_rehashing = seen_rehashing || map.IsRehashing();
+        }
+        assert(seen_rehashing && hash_calls == 4900u);
+        bool exception_was_thrown = false;
+        try {
+            map.Insert(13, 0);
+        } catch (const std::runtime_error&) {
+            exception_was_thrown = true;
+        }
+        assert(exception_was_thrown && map.GetSize() == 5000u);
+        refuse_13 = false;
+        for (int i = 0; i < 5000; ++i) {
+            assert(*map.Find(i) == i);
+        }
+    }
+}
+
+void Test23() {
+    using List = StaticSingleLinkedList<std::string, 4>;
+    static_assert(List::GetCapacity() == 4u);
+
+    // Тот же интерфейс, что у SingleLinkedList; вставка в заполненный список не меняет его
+    {
+        List list{"b", "c"};
+        list.PushFront("a");
+        assert(list.GetSize() == 3u && !list.IsFull());
+        const auto it = list.InsertAfter(std::next(list.cbegin()), "x");
+        assert(*it == "x" && list.IsFull());
+        assert((std::vector<std::string>(list.begin(), list.end()) == std::vector<std::string>{"a", "b", "x", "c"}));
+        assert(!list.TryPushFront("z") && list.TryInsertAfter(list.cbegin(), "z") == list.end());
+        try {
+            list.PushFront("z");
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        assert(list.GetSize() == 4u && *list.begin() == "a");
+
+        // Освобождённые ячейки используются снова
+        assert(*list.EraseAfter(list.cbegin()) == "x");
+        list.PopFront();
+        list.PushFront("y");
+        list.InsertAfter(list.cbefore_begin(), "w");
+        assert((std::vector<std::string>(list.begin(), list.end()) == std::vector<std::string>{"w", "y", "x", "c"}));
+        for (std::string& value : list) {
+            value += "!";
+        }
+        assert(*std::as_const(list).begin() == "w!");
+
+        List copy = list;
+        assert(copy == list && !(copy < list) && copy <= list);
+        copy.PopFront();
+        assert(copy != list && list < copy);
+        List moved = std::move(copy);
+        assert(copy.IsEmpty() && moved.GetSize() == 3u && *moved.begin() == "y!");
+        swap(moved, list);
+        assert(list.GetSize() == 3u && moved.GetSize() == 4u && *moved.begin() == "w!");
+        list = moved;
+        assert(list == moved);
+        list.Clear();
+        assert(list.IsEmpty() && list.begin() == list.end());
+        list.PushFront("again");
+        assert(*list.begin() == "again");
+
+        try {
+            List overflow{"1", "2", "3", "4", "5"};
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+    }
+
+    // Случайные изменения сверяются с SingleLinkedList
+    {
+        constexpr size_t kCapacity = 64;
+        StaticSingleLinkedList<int, kCapacity> list;
+        SingleLinkedList<int> expected;
+        std::mt19937 generator(13);
+        for (int i = 0; i < 50000; ++i) {
+            const size_t position = expected.IsEmpty() ? 0 : generator() % (expected.GetSize() + 1);
+            switch (generator() % 4) {
+            case 0:
+                if (list.TryPushFront(i)) {
+                    expected.PushFront(i);
+                }
+                assert(list.GetSize() <= kCapacity);
+                break;
+            case 1:
+                if (!list.IsFull()) {
+                    list.InsertAfter(std::next(list.cbefore_begin(), static_cast<std::ptrdiff_t>(position)), i);
+                    expected.InsertAfter(std::next(expected.cbefore_begin(), static_cast<std::ptrdiff_t>(position)), i);
+                }
+                break;
+            case 2:
+                if (position < expected.GetSize()) {
+                    list.EraseAfter(std::next(list.cbefore_begin(), static_cast<std::ptrdiff_t>(position)));
+                    expected.EraseAfter(std::next(expected.cbefore_begin(), static_cast<std::ptrdiff_t>(position)));
+                }
+                break;
+            default:
+                if (!list.IsEmpty()) {
+                    list.PopFront();
+                    expected.PopFront();
+                }
+            }
+            assert(list.GetSize() == expected.GetSize());
+            assert(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    // Исключение при копировании элемента оставляет ячейку свободной
+    {
+        struct ThrowOnCopy {
+            ThrowOnCopy() = default;
+            ThrowOnCopy(const ThrowOnCopy& other) : fail(other.fail) {
+                if (fail) {
+                    throw std::runtime_error("copy failed");
+                }
+            }
+            bool fail = false;
+        };
+        StaticSingleLinkedList<ThrowOnCopy, 2> list;
+        list.PushFront(ThrowOnCopy{});
+        ThrowOnCopy failing;
+        failing.fail = true;
+        try {
+            list.PushFront(failing);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(list.GetSize() == 1u && !list.IsFull());
+        list.PushFront(ThrowOnCopy{});
+        assert(list.IsFull());
+    }
+
+    // Перемещение и обмен переносят элементы перемещением, без копий
+    {
+        static int copies = 0;
+        static int moves = 0;
+        struct Counted {
+            Counted(int v) : value(v) {}
+            Counted(const Counted& other) : value(other.value) {
+                ++copies;
+            }
+            Counted(Counted&& other) noexcept : value(other.value) {
+                ++moves;
+            }
+            int value;
+        };
+        StaticSingleLinkedList<Counted, 4> list{1, 2};
+        StaticSingleLinkedList<Counted, 4> other{3};
+        copies = moves = 0;
+        StaticSingleLinkedList<Counted, 4> moved(std::move(list));
+        assert(copies == 0 && moves == 2);
+        list = std::move(moved);
+        assert(copies == 0 && moves == 4);
+        // Три переноса через временный список: 1 + 2 + 1 элемент
+        list.swap(other);
+        assert(copies == 0 && moves == 4 + 4);
+        assert(list.GetSize() == 1u && list.begin()->value == 3 && other.begin()->value == 1);
+
+        // Список только перемещаемых элементов
+        using PtrList = StaticSingleLinkedList<std::unique_ptr<int>, 3>;
+        std::vector<std::unique_ptr<int>> pointers;
+        pointers.push_back(std::make_unique<int>(1));
+        pointers.push_back(std::make_unique<int>(2));
+        PtrList pointer_list(std::make_move_iterator(pointers.begin()), std::make_move_iterator(pointers.end()));
+        PtrList moved_pointers(std::move(pointer_list));
+        PtrList empty_pointers;
+        swap(moved_pointers, empty_pointers);
+        assert(moved_pointers.IsEmpty() && empty_pointers.GetSize() == 2u && **empty_pointers.begin() == 1);
+        static_assert(std::is_nothrow_move_constructible_v<PtrList>);
+    }
+}
+
+// Цепочка, построенная во время компиляции: квадраты чисел от 1 до N по возрастанию, без чётных
+template <size_t N>
+constexpr ConstexprSingleLinkedList<int, N> MakeOddSquares() {
+    ConstexprSingleLinkedList<int, N> list;
+    for (int i = static_cast<int>(N); i > 0; --i) {
+        list.PushFront(i * i);
+    }
+    for (auto prev = list.cbefore_begin(); std::next(prev) != list.cend();) {
+        if (*std::next(prev) % 2 == 0) {
+            list.EraseAfter(prev);
+        } else {
+            ++prev;
+        }
+    }
+    return list;
+}
+
+void Test24() {
+    using List = ConstexprSingleLinkedList<int, 8>;
+
+    // Список строится и проверяется во время компиляции
+    {
+        constexpr auto squares = MakeOddSquares<8>();
+        static_assert(squares.GetSize() == 4);
+        static_assert(*squares.begin() == 1 && *std::next(squares.begin(), 3) == 49);
+        static_assert(squares.Find(25) != squares.end() && squares.Find(4) == squares.end());
+        static_assert(squares == ConstexprSingleLinkedList<int, 8>{1, 9, 25, 49});
+        static_assert(squares < ConstexprSingleLinkedList<int, 8>{1, 9, 25, 50});
+
+        // Освобождённые ячейки используются снова, а пустые ячейки равны Type{}
+        constexpr auto refilled = [] {
+            List list{1, 2, 3};
+            list.PopFront();
+            list.InsertAfter(list.cbegin(), 5);
+            list.Clear();
+            list.PushFront(7);
+            return list;
+        }();
+        static_assert(refilled.GetSize() == 1 && *refilled.begin() == 7);
+
+        // Во время выполнения готовый список читается как обычный
+        const std::vector<int> values(squares.begin(), squares.end());
+        assert((values == std::vector<int>{1, 9, 25, 49}));
+    }
+
+    // Те же операции во время выполнения
+    {
+        List list{2, 3};
+        list.PushFront(1);
+        for (int& value : list) {
+            value *= 10;
+        }
+        assert((std::vector<int>(list.begin(), list.end()) == std::vector<int>{10, 20, 30}));
+        assert(*list.EraseAfter(list.cbegin()) == 30);
+        const List copy = list;
+        assert(copy == list && copy.GetSize() == 2u);
+        while (!list.IsFull()) {
+            list.PushFront(0);
+        }
+        try {
+            list.PushFront(0);
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        assert(list.GetSize() == List::GetCapacity() && copy != list);
+    }
+}
+
+void Test25() {
+    using List = SingleLinkedList<InlineProbe>;
+    using Stats = ListStatsRegistry<InlineProbe>;
+    const auto probe = [](int value) {
+        // Длинная строка не помещается в сам std::string и лежит в куче
+        return InlineProbe{std::string(24, 'a') + std::to_string(value)};
+    };
+    const auto values = [&](const List& list) {
+        std::vector<int> result;
+        for (const InlineProbe& item : list) {
+            result.push_back(std::stoi(item.text.substr(24)));
+        }
+        return result;
+    };
+    const auto fill = [&](List& list, int first, int count) {
+        auto tail = list.cbefore_begin();
+        while (std::next(tail) != list.cend()) {
+            ++tail;
+        }
+        for (int i = 0; i < count; ++i) {
+            tail = list.InsertAfter(tail, probe(first + i));
+        }
+    };
+    Stats::Reset();
+
+    // Первые четыре узла не обращаются к куче; пятый выделяется в ней, а встроенные остаются на месте
+    {
+        List list;
+        fill(list, 1, 4);
+        assert(Stats::Get().heap_allocations == 0u);
+        ListMemoryUsage usage = list.MemoryUsage();
+        assert(usage.inline_nodes == 4u && usage.heap_nodes == 0u && usage.allocator_overhead == 0u);
+        // Индекс позиций (SINGLE_LINKED_LIST_POSITION_INDEX) добавил бы к объекту память своих массивов
+        if constexpr (!EnableListPositionIndex<InlineProbe>::value) {
+            assert(usage.container_bytes == sizeof(List) - 4 * usage.node_size);
+        }
+
+        const auto first = list.cbegin();
+        const auto fourth = std::next(first, 3);
+        list.PushFront(probe(0));
+        fill(list, 5, 2);
+        assert(Stats::Get().heap_allocations == 3u);
+        assert(first->text == probe(1).text && std::next(fourth)->text == probe(5).text);
+        assert((values(list) == std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+        usage = list.MemoryUsage();
+        assert(usage.inline_nodes == 4u && usage.heap_nodes == 3u);
+
+        // Освободившаяся ячейка занимается снова
+        list.EraseAfter(list.cbegin());
+        list.InsertAfter(fourth, probe(9));
+        assert(Stats::Get().heap_allocations == 3u);
+        assert((values(list) == std::vector<int>{0, 2, 3, 4, 9, 5, 6}));
+        assert(List(list) == list);
+    }
+    assert(Stats::Get().live_nodes == 0u && Stats::Get().bytes_outstanding == 0u);
+
+    // Перемещение переносит элементы встроенных ячеек в те же ячейки нового списка
+    {
+        List source;
+        fill(source, 1, 6);
+        const auto second = std::next(source.cbegin());
+        const auto fifth = std::next(second, 3);
+        List moved(std::move(source));
+        assert(source.IsEmpty() && source.MemoryUsage().inline_nodes == 0u);
+        assert((values(moved) == std::vector<int>{1, 2, 3, 4, 5, 6}));
+        assert(moved.Relocated(second, source)->text == probe(2).text);
+        assert(moved.Relocated(fifth, source) == fifth);
+        assert(moved.Relocated(source.cbefore_begin(), source) == moved.cbefore_begin());
+
+        // Оба списка пригодны к дальнейшей работе
+        fill(source, 7, 5);
+        moved.EraseAfter(moved.Relocated(second, source));
+        fill(moved, 8, 1);
+        assert((values(source) == std::vector<int>{7, 8, 9, 10, 11}));
+        assert((values(moved) == std::vector<int>{1, 2, 4, 5, 6, 8}));
+
+        source = std::move(moved);
+        assert(moved.IsEmpty() && (values(source) == std::vector<int>{1, 2, 4, 5, 6, 8}));
+    }
+
+    // Обмен списка с самим собой ничего не меняет
+    {
+        List list;
+        fill(list, 1, 6);
+        const auto second = std::next(list.cbegin());
+        list.swap(list);
+        using std::swap;
+        swap(list, list);
+        assert((values(list) == std::vector<int>{1, 2, 3, 4, 5, 6}));
+        assert(second->text == probe(2).text && list.MemoryUsage().inline_nodes == 4u);
+        list = std::move(list);
+        assert(list.GetSize() == 6u);
+    }
+
+    // Обмен: списки во встроенных ячейках, со спиллом в кучу и пустые. Порядок элементов
+    // не совпадает с порядком ячеек, а после обмена оба списка продолжают работать
+    for (int left_size : {0, 2, 4, 7}) {
+        for (int right_size : {0, 3, 4, 9}) {
+            List left;
+            List right;
+            fill(left, 100, left_size);
+            fill(right, 200, right_size);
+            if (left_size > 1) {
+                left.PopFront();
+                left.PushFront(probe(199));
+                left.InsertAfter(std::next(left.cbegin()), probe(198));
+            }
+            auto left_model = values(left);
+            auto right_model = values(right);
+            const size_t left_inline = left.MemoryUsage().inline_nodes;
+            const size_t right_inline = right.MemoryUsage().inline_nodes;
+
+            swap(left, right);
+            assert(values(left) == right_model && values(right) == left_model);
+            assert(left.MemoryUsage().inline_nodes == right_inline && right.MemoryUsage().inline_nodes == left_inline);
+
+            left.PushFront(probe(1));
+            fill(left, 2, 2);
+            right.PushFront(probe(3));
+            if (!left_model.empty()) {
+                right.EraseAfter(right.cbegin());
+                left_model.erase(left_model.begin());
+            }
+            left_model.insert(left_model.begin(), 3);
+            right_model.insert(right_model.begin(), 1);
+            right_model.push_back(2);
+            right_model.push_back(3);
+            assert(values(left) == right_model && values(right) == left_model);
+        }
+    }
+    assert(Stats::Get().live_nodes == 0u && Stats::Get().bytes_outstanding == 0u);
+
+    // Сращивание: встроенные узлы other занимают свободные ячейки списка, остальные переносятся в кучу
+    {
+        List list;
+        fill(list, 1, 3);
+        List other;
+        fill(other, 10, 6);
+        const size_t allocations = Stats::Get().heap_allocations;
+        list.SpliceAfter(list.cbegin(), other, std::next(other.cbegin(), 5));
+        assert(Stats::Get().heap_allocations == allocations + 3);
+        assert(other.IsEmpty() && other.MemoryUsage().inline_nodes == 0u);
+        assert((values(list) == std::vector<int>{1, 10, 11, 12, 13, 14, 15, 2, 3}));
+        assert(list.MemoryUsage().inline_nodes == 4u && list.MemoryUsage().heap_nodes == 5u);
+        fill(other, 20, 2);
+        assert(Stats::Get().heap_allocations == allocations + 3);
+        list.SpliceAfter(list.cbefore_begin(), other, std::next(other.cbegin()));
+        assert((values(list) == std::vector<int>{20, 21, 1, 10, 11, 12, 13, 14, 15, 2, 3}));
+
+        // Уплотнение переносит в слаб и встроенные узлы, освобождая ячейки
+        const List::CompactionResult result = list.Compact();
+        assert(result.nodes_relocated == 11u);
+        assert(list.MemoryUsage().inline_nodes == 0u && list.MemoryUsage().pooled_nodes == 11u);
+        list.PushFront(probe(0));
+        assert(list.MemoryUsage().inline_nodes == 1u);
+        assert((values(list) == std::vector<int>{0, 20, 21, 1, 10, 11, 12, 13, 14, 15, 2, 3}));
+    }
+    assert(Stats::Get().live_nodes == 0u && Stats::Get().bytes_outstanding == 0u);
+
+    // Случайные операции над парой списков сверяются с std::vector
+    {
+        std::mt19937 generator(49);
+        List lists[2];
+        std::vector<int> models[2];
+        int next_value = 0;
+        for (int step = 0; step < 3000; ++step) {
+            const size_t index = generator() % 2;
+            List& list = lists[index];
+            List& other = lists[1 - index];
+            std::vector<int>& model = models[index];
+            std::vector<int>& other_model = models[1 - index];
+            const size_t position = generator() % (model.size() + 1);
+            switch (generator() % 8) {
+            case 0:
+            case 1:
+                if (model.size() < 12) {
+                    list.InsertAfter(list.Advance(list.cbefore_begin(), position), probe(next_value));
+                    model.insert(model.begin() + static_cast<std::ptrdiff_t>(position), next_value++);
+                }
+                break;
+            case 2:
+            case 3:
+                if (position < model.size()) {
+                    list.EraseAfter(list.Advance(list.cbefore_begin(), position));
+                    model.erase(model.begin() + static_cast<std::ptrdiff_t>(position));
+                }
+                break;
+            case 4:
+                list.swap(other);
+                std::swap(model, other_model);
+                break;
+            case 5:
+                if (!other.IsEmpty()) {
+                    list.SpliceAfter(list.Advance(list.cbefore_begin(), position), other,
+                                     other.Advance(other.cbegin(), other_model.size() - 1));
+                    model.insert(model.begin() + static_cast<std::ptrdiff_t>(position), other_model.begin(),
+                                 other_model.end());
+                    other_model.clear();
+                }
+                break;
+            case 6:
+                if (generator() % 2 == 0) {
+                    list = std::move(other);
+                    model = std::move(other_model);
+                    other_model.clear();
+                } else {
+                    list = other;
+                    model = other_model;
+                }
+                break;
+            default:
+                list.CompactStep(generator() % 4 + 1);
+                break;
+            }
+            assert(values(lists[0]) == models[0] && values(lists[1]) == models[1]);
+            assert(lists[0].GetSize() == models[0].size() && lists[1].GetSize() == models[1].size());
+        }
+    }
+    assert(Stats::Get().live_nodes == 0u && Stats::Get().bytes_outstanding == 0u);
+
+    // Обёртки, хранящие итераторы на узлы, пересчитывают их при перемещении и обмене
+    {
+        SortedSingleLinkedList<InlineProbe> sorted{probe(5), probe(3), probe(8)};
+        SortedSingleLinkedList<InlineProbe> other{probe(1), probe(9)};
+        swap(sorted, other);
+        assert(sorted.Find(probe(9)) != sorted.end() && other.Find(probe(3)) != other.end());
+        other.InsertSorted(probe(4));
+        assert(other.EraseValue(probe(5)) == 1u && *other.LowerBound(probe(4)) == probe(4));
+        SortedSingleLinkedList<InlineProbe> moved(std::move(other));
+        assert(*moved.begin() == probe(3) && *moved.LowerBound(probe(7)) == probe(8));
+        assert(moved.Find(probe(8)) != moved.end() && moved.GetSize() == 3u);
+
+        HashIndexedSingleLinkedList<InlineProbe, InlineProbeHash> indexed{probe(1), probe(2), probe(3)};
+        HashIndexedSingleLinkedList<InlineProbe, InlineProbeHash> other_indexed{probe(7)};
+        indexed.swap(other_indexed);
+        assert(indexed.Contains(probe(7)) && other_indexed.Contains(probe(2)));
+        assert(other_indexed.EraseValue(probe(1)) == 1u && other_indexed.EraseValue(probe(2)) == 1u);
+        other_indexed.PushFront(probe(4));
+        HashIndexedSingleLinkedList<InlineProbe, InlineProbeHash> moved_indexed(std::move(other_indexed));
+        assert(moved_indexed.Contains(probe(4)) && moved_indexed.Contains(probe(3)));
+        assert(moved_indexed.EraseValue(probe(3)) == 1u && moved_indexed.GetSize() == 1u);
+        assert(*moved_indexed.Find(probe(4)) == probe(4));
+    }
+    assert(Stats::Get().live_nodes == 0u && Stats::Get().bytes_outstanding == 0u);
+}
+
+void Test26() {
+    static_assert(ListTrivialValues<int>::value && ListTrivialValues<double>::value);
+    static_assert(ListTrivialValues<StatsProbe>::value && !ListTrivialValues<OpaqueBytes>::value);
+    static_assert(!ListTrivialValues<std::string>::value && !ListTrivialValues<InlineProbe>::value);
+
+    // Длинная копия тривиальных значений лежит в одном слабе, короткая - по узлу в куче
+    {
+        SingleLinkedList<int> list;
+        for (int i = 40; i > 0; --i) {
+            list.PushFront(i);
+        }
+        SingleLinkedList<int> copy(list);
+        assert(copy == list && copy.GetSize() == 40u);
+        ListMemoryUsage usage = copy.MemoryUsage();
+        assert(usage.pooled_nodes + usage.inline_nodes == 40u && usage.heap_nodes == 0u);
+        assert(usage.inline_nodes == ListInlineNodes<int>::value);
+
+        // Копия пригодна к изменениям, а очистка освобождает слаб
+        copy.EraseAfter(copy.Advance(copy.cbegin(), 9));
+        copy.PushFront(0);
+        copy.InsertAfter(copy.Advance(copy.cbegin(), 39), 41);
+        assert(copy.GetSize() == 41u && *copy.begin() == 0 && copy.At(40) == 41 && copy.At(11) == 12);
+        copy.Clear();
+        assert(copy.IsEmpty() && copy.MemoryUsage().pooled_nodes == 0u);
+        copy = list;
+        assert(copy == list);
+
+        const SingleLinkedList<int> small{1, 2, 3};
+        const SingleLinkedList<int> small_copy(small);
+        usage = small_copy.MemoryUsage();
+        assert(usage.heap_nodes + usage.inline_nodes == 3u && usage.pooled_nodes == 0u);
+
+        const SingleLinkedList<double> from_values{1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5,
+                                                   9.5, 10.5, 11.5, 12.5, 13.5, 14.5, 15.5, 16.5};
+        assert(from_values.MemoryUsage().pooled_nodes + from_values.MemoryUsage().inline_nodes == 16u);
+        assert(from_values.At(0) == 1.5 && from_values.At(15) == 16.5);
+    }
+
+    // С выключенным побайтовым путём копия остаётся поэлементной
+    {
+        SingleLinkedList<OpaqueBytes> list;
+        for (int i = 0; i < 20; ++i) {
+            list.PushFront(OpaqueBytes{i});
+        }
+        const SingleLinkedList<OpaqueBytes> copy(list);
+        assert(copy.MemoryUsage().heap_nodes + copy.MemoryUsage().inline_nodes == 20u);
+        assert(copy.MemoryUsage().pooled_nodes == 0u);
+        assert(copy.begin()->value == 19);
+    }
+
+    // Встроенные ячейки заполняются первыми, остальные узлы копии - в слабе
+    {
+        SingleLinkedList<short> list;
+        for (short i = 20; i > 0; --i) {
+            list.PushFront(i);
+        }
+        SingleLinkedList<short> copy(list);
+        const ListMemoryUsage usage = copy.MemoryUsage();
+        assert(usage.inline_nodes == 4u && usage.pooled_nodes == 16u && usage.heap_nodes == 0u);
+        assert(copy == list);
+        copy.Clear();
+        assert(copy.MemoryUsage().inline_nodes == 0u);
+        copy.PushFront(7);
+        assert(copy.MemoryUsage().inline_nodes == 1u && copy.GetSize() == 1u);
+    }
+
+    // Кэш хэша и индекс позиций переходят в копию и работают после очистки
+    {
+        SingleLinkedList<unsigned> hashed;
+        for (unsigned i = 0; i < 50; ++i) {
+            hashed.PushFront(i * 7u);
+        }
+        const SingleLinkedList<unsigned> copy(hashed);
+        assert(copy.GetHash() == hashed.GetHash() && std::hash<SingleLinkedList<unsigned>>()(copy) == copy.GetHash());
+        hashed.Clear();
+        assert(hashed.GetHash() == SingleLinkedList<unsigned>().GetHash());
+
+        SingleLinkedList<long> indexed;
+        for (long i = 299; i >= 0; --i) {
+            indexed.PushFront(i);
+        }
+        SingleLinkedList<long> indexed_copy(indexed);
+        assert(indexed_copy.At(257) == 257 && *indexed_copy.IteratorAt(33) == 33);
+        indexed_copy.Clear();
+        indexed_copy.PushFront(5);
+        assert(indexed_copy.At(0) == 5);
+    }
+
+    // Очистка списка с узлами в куче, в слабах и в освободившихся ячейках слабов сходится со статистикой
+    {
+        using ProbeList = SingleLinkedList<StatsProbe>;
+        ListStatsRegistry<StatsProbe>::Reset();
+        {
+            ProbeList list;
+            for (int i = 0; i < 30; ++i) {
+                list.PushFront(StatsProbe{i});
+            }
+            ProbeList copy(list);
+            ListStats stats = ProbeList::GetStats();
+            assert(stats.heap_allocations == 31u && stats.value_copies == 60u && stats.live_nodes == 60u);
+
+            list.CompactStep(10);
+            list.PopFront();
+            list.PushFront(StatsProbe{100});
+            copy.PushFront(StatsProbe{101});
+            list.Clear();
+            copy.Clear();
+            stats = ProbeList::GetStats();
+            assert(stats.live_nodes == 0u && stats.nodes_destroyed == stats.nodes_created);
+            assert(stats.bytes_outstanding == 0u && stats.heap_frees == stats.heap_allocations);
+
+            list.PushFront(StatsProbe{1});
+            assert(list.GetSize() == 1u && list.begin()->value == 1);
+        }
+        assert(ProbeList::GetStats().live_nodes == 0u && ProbeList::GetStats().bytes_outstanding == 0u);
+    }
+}
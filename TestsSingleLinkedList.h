@@ -1,4 +1,17 @@
 #pragma once
 #include "SingleLinkedList.h"
+#include "ConstexprSingleLinkedList.h"
+#include "CowSingleLinkedList.h"
+#include "HashIndexedSingleLinkedList.h"
+#include "LinkedHashMap.h"
+#include "LruCache.h"
+#include "MappedSingleLinkedList.h"
+#include "ShardedSingleLinkedList.h"
+#include "SortedSingleLinkedList.h"
+#include "StaticSingleLinkedList.h"
+#include "ParallelSingleLinkedList.h"
+#include "PersistentSingleLinkedList.h"
+#include "PrefetchSingleLinkedList.h"
+#include "StreamingSingleLinkedList.h"
 
 void RunTests();
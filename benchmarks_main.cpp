@@ -0,0 +1,17 @@
+#include <exception>
+#include <iostream>
+#include "BenchmarksSingleLinkedList.h"
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+    try {
+        RunBenchmarks(ParseBenchmarkOptions(argc, argv));
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    cout << "Benchmarks finished!" << endl;
+    return 0;
+}